@@ -29,9 +29,24 @@
  *
  **********************************************************************************/
 #include <boost/filesystem.hpp>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <set>
 #include "DWAccelerator.hpp"
+#include "DWDistributedSampler.hpp"
+#include "DWGaugeSampler.hpp"
+#include "DWHedgingSampler.hpp"
+#include "DWSplitSampler.hpp"
+#include "EmbeddingAlgorithm.hpp"
+#include "HardwareTiler.hpp"
+#include "SampleAggregation.hpp"
+#include "SamplingMonitor.hpp"
+#include "SplitMix64.hpp"
+#include "SteepestDescent.hpp"
+#include "TemperatureEstimator.hpp"
+#include "Unembedder.hpp"
 #include "ParameterSetter.hpp"
 
 namespace xacc {
@@ -48,7 +63,7 @@ std::shared_ptr<AcceleratorBuffer> DWAccelerator::createBuffer(
 		xacc::error(solverName + " is not available for creating a buffer.");
 	}
 	auto solver = availableSolvers[solverName];
-	auto buffer = std::make_shared<AQCAcceleratorBuffer>(varId, solver.nQubits);
+	auto buffer = std::make_shared<DWAcceleratorBuffer>(varId, solver.nQubits);
 	storeBuffer(varId, buffer);
 	return buffer;
 }
@@ -59,7 +74,7 @@ std::shared_ptr<AcceleratorBuffer> DWAccelerator::createBuffer(
 		xacc::error("Invalid buffer size.");
 	}
 
-	auto buffer = std::make_shared<AQCAcceleratorBuffer>(varId, size);
+	auto buffer = std::make_shared<DWAcceleratorBuffer>(varId, size);
 	storeBuffer(varId, buffer);
 	return buffer;
 }
@@ -70,6 +85,20 @@ bool DWAccelerator::isValidBufferSize(const int NBits) {
 
 
 void DWAccelerator::initialize() {
+	if (isLocalSampler()) {
+		// Local samplers run offline, so emulate the Chimera
+		// topology of the requested solver instead of asking SAPI.
+		std::string solverName = "DW_2000Q_VFYC_2";
+		if (xacc::optionExists("dwave-solver")) {
+			solverName = xacc::getOption("dwave-solver");
+		}
+		if (!availableSolvers.count(solverName)) {
+			availableSolvers.insert(std::make_pair(solverName,
+					makeChimeraSolver(solverName, 16, 16, 4)));
+		}
+		return;
+	}
+
 	searchAPIKey(apiKey, url);
 
 	// Set up the extra HTTP headers we are going to need
@@ -77,6 +106,15 @@ void DWAccelerator::initialize() {
 	headers.insert({"Content-type", "application/x-www-form-urlencoded"});
 	headers.insert({"Accept", "*/*"});
 
+	fetchSolvers();
+
+	remoteUrl = url;
+	postPath = "/sapi/problems";
+	remoteSampler = std::make_shared<DWRemoteSampler>(restClient, url, headers);
+}
+
+
+void DWAccelerator::fetchSolvers() {
 	auto message = handleExceptionRestClientGet(url, "/sapi/solvers/remote", headers);
 
 	Document document;
@@ -97,23 +135,39 @@ void DWAccelerator::initialize() {
 			}
 			solver.nQubits = document[i]["properties"]["num_qubits"].GetInt();
 
+			// The limits requests are split under
+			auto& properties = document[i]["properties"];
+			if (properties.FindMember("num_reads_range") != properties.MemberEnd()) {
+				solver.maxReads = properties["num_reads_range"][1].GetInt();
+			}
+			if (properties.FindMember("problem_run_duration_range") != properties.MemberEnd()) {
+				solver.maxRunDuration = properties["problem_run_duration_range"][1].GetDouble();
+			}
+			if (properties.FindMember("default_readout_thermalization") != properties.MemberEnd()) {
+				solver.readoutThermalization = properties["default_readout_thermalization"].GetDouble();
+			}
+
+			// The load SAPI reports, when it does, to route by
+			if (document[i].FindMember("avg_load") != document[i].MemberEnd()
+					&& document[i]["avg_load"].IsNumber()) {
+				solver.averageLoad = document[i]["avg_load"].GetDouble();
+			}
+
 			// Get the connectivity
 			auto couplers = document[i]["properties"]["couplers"].GetArray();
 			for (int j = 0; j < couplers.Size(); j++) {
 				solver.edges.push_back(std::make_pair(couplers[j][0].GetInt(), couplers[j][1].GetInt()));
 			}
-			availableSolvers.insert(std::make_pair(solver.name, solver));
+			availableSolvers[solver.name] = solver;
 		}
 	}
-
-	remoteUrl = url;
-	postPath = "/sapi/problems";
+	solversFetched = std::chrono::steady_clock::now();
 }
 
-
-const std::string DWAccelerator::processInput(
-                std::shared_ptr<AcceleratorBuffer> buffer,
-                std::vector<std::shared_ptr<Function>> functions) {
+std::shared_ptr<DWKernel> DWAccelerator::buildPhysicalKernel(
+		std::shared_ptr<AcceleratorBuffer> buffer,
+		std::vector<std::shared_ptr<Function>> functions,
+		AnnealSchedule& schedule) {
 
 	if (functions.size() > 1)
 		xacc::error("D-Wave Accelerator can only launch one job at a time.");
@@ -182,148 +236,800 @@ const std::string DWAccelerator::processInput(
 	for (auto i : insts) {
 		newKernel->addInstruction(i);
 	}
-    
-	std::vector<std::string> splitLines;
-	boost::split(splitLines, newKernel->toString(""), boost::is_any_of("\n"));
-	auto nQMILines = splitLines.size();
-	std::string jsonStr = "", solverName = "DW_2000Q_VFYC_2", solveType =
-			"ising", trials = "100", annealTime = "20";
-
-	if (xacc::optionExists("dwave-solver")) {
-		solverName = xacc::getOption("dwave-solver");
-	}
-
-	if (!availableSolvers.count(solverName)) {
-		xacc::error(solverName + " is not available.");
-	}
-
-    if (xacc::optionExists("dwave-solve-type")) {
-        solveType = xacc::getOption("dwave-solve-type");
-    }
-    
-	auto solver = availableSolvers[solverName];
 
+	std::string annealTime = "20";
 	if (xacc::optionExists("dwave-anneal-time")) {
 		annealTime = xacc::getOption("dwave-anneal-time");
 	}
 
-    std::vector<std::pair<double,double>> as;
-    std::string annealingStr = "";
     AnnealScheduleGenerator gen;
     double s = 1;
+    schedule.clear();
     if (annealingSchedule) {
-        as = gen.generate(annealingSchedule);
+        schedule = gen.generate(annealingSchedule);
     } else {
-        as.push_back({0,0});
-        as.push_back({std::stod(annealTime), s});
+        schedule.push_back({0,0});
+        schedule.push_back({std::stod(annealTime), s});
     }
-    
-    annealingStr = gen.getAsString(as);
-    xacc::info("Annealing Schedule: " + annealingStr);
 
-	if (xacc::optionExists("dwave-num-reads")) {
-		trials = xacc::getOption("dwave-num-reads");
+	return newKernel;
+}
+
+const std::string DWAccelerator::processInput(
+                std::shared_ptr<AcceleratorBuffer> buffer,
+                std::vector<std::shared_ptr<Function>> functions) {
+
+	AnnealSchedule as;
+	auto newKernel = buildPhysicalKernel(buffer, functions, as);
+	auto problem = toIsingProblem(newKernel);
+	auto params = getSamplerParameters(as);
+
+	if (!remoteSampler) {
+		xacc::error("The D-Wave Accelerator has not been initialized.");
 	}
+	remoteSampler->setSolver(getSolver());
+	remoteOffset = problem.getOffset();
+	remotePhysicalProblem = std::make_shared<IsingProblem>(problem);
+	remoteLogicalProblem = std::make_shared<IsingProblem>(toIsingProblem(
+			std::dynamic_pointer_cast<DWKernel>(functions[0])));
+	return remoteSampler->getProblemJson(problem, params);
+}
+
+void DWAccelerator::execute(std::shared_ptr<AcceleratorBuffer> buffer,
+		const std::shared_ptr<Function> function) {
 
-	jsonStr += "[{ \"solver\" : \"" + solverName + "\", \"type\" : \""
-			+ solveType + "\", \"data\" : \"" + std::to_string(solver.nQubits)
-			+ " " + std::to_string(nQMILines - 1) + "\\n"
-			+ newKernel->toString("") + "\", \"params\": { \"num_reads\" : "
-			+ trials + ", \"anneal_schedule\" : " + annealingStr +
-            + ", \"auto_scale\" : true } }]";
-	boost::replace_all(jsonStr, "\n", "\\n");
+	AnnealSchedule as;
+	auto newKernel = buildPhysicalKernel(buffer, {function}, as);
+	auto problem = toIsingProblem(newKernel);
+	auto params = getSamplerParameters(as);
 
-	return jsonStr;
+	auto sampler = getSampler();
+	auto samples = xacc::optionExists("dwave-adaptive-chunk-size") ?
+			sampleAdaptively(sampler, problem, params) :
+			sampler->sample(problem, params);
+	auto logical = toIsingProblem(std::dynamic_pointer_cast<DWKernel>(function));
+	storeSamples(buffer, samples, &problem, &logical);
 }
 
-std::vector<std::shared_ptr<AcceleratorBuffer>> DWAccelerator::processResponse(
-                std::shared_ptr<AcceleratorBuffer> buffer,
-                const std::string& response) {
+std::vector<std::shared_ptr<AcceleratorBuffer>> DWAccelerator::executeTiled(
+		std::shared_ptr<AcceleratorBuffer> buffer,
+		const std::vector<std::shared_ptr<Function>> functions) {
 
-	auto aqcBuffer = std::dynamic_pointer_cast<AQCAcceleratorBuffer>(buffer);
+	auto solver = getSolver();
+	HardwareTiler tiler(solver.nQubits, solver.edges);
+	auto embeddingAlgorithm = xacc::getService<EmbeddingAlgorithm>(
+			xacc::optionExists("dwave-embedding") ?
+					xacc::getOption("dwave-embedding") : "cmr");
 
-	bool jobCompleted = false;
-	Document doc;
-	// Parse the json string
-	doc.Parse(response);
+	// Embed the problem graph onto the smallest free region it fits,
+	// doubling the region until it spans every free qubit, and
+	// return the embedding over physical qubits, or an empty one
+	auto embedTile = [&](std::shared_ptr<DWGraph> problemGraph,
+			const std::set<int>& vertices) {
+		int size = std::max(8, 2 * static_cast<int>(vertices.size()));
+		while (tiler.getNumberOfFreeQubits() > 0) {
+			size = std::min(size, tiler.getNumberOfFreeQubits());
+			auto region = tiler.getRegion(size);
+			auto regionGraph = std::make_shared<AcceleratorGraph>(region.size());
+			for (auto& e : tiler.getEdges(region)) {
+				regionGraph->addEdge(e.first, e.second);
+			}
 
-	// Get the JobID
-	std::string jobId = std::string(doc[0]["id"].GetString());
+			auto local = embeddingAlgorithm->embed(problemGraph, regionGraph);
+			bool embedded = true;
+			for (auto v : vertices) {
+				auto chain = local.find(v);
+				embedded = embedded && chain != local.end() && !chain->second.empty();
+			}
+			if (embedded) {
+				Embedding embedding;
+				std::vector<int> qubits;
+				for (auto& kv : local) {
+					std::vector<int> chain;
+					for (auto q : kv.second) {
+						chain.push_back(region[q]);
+					}
+					qubits.insert(qubits.end(), chain.begin(), chain.end());
+					embedding.insert(std::make_pair(kv.first, chain));
+				}
+				tiler.allocate(qubits);
+				return embedding;
+			}
+			if (size == tiler.getNumberOfFreeQubits()) {
+				break;
+			}
+			size *= 2;
+		}
+		return Embedding();
+	};
 
-	// Loop until the job is complete,
-	// get the JSON response
-	std::string msg = handleExceptionRestClientGet(url, "/sapi/problems/"+jobId, headers);
-	while (!jobCompleted) {
+	struct Tile {
+		std::shared_ptr<AcceleratorBuffer> buffer;
+		IsingProblem physical;
+		IsingProblem logical;
+	};
+	std::vector<Tile> tiles;
+	AnnealSchedule schedule;
 
-		// Execute HTTP Get
-		msg = handleExceptionRestClientGet(url, "/sapi/problems/"+jobId, headers);
+	// Run the tiles placed so far as one physical problem,
+	// then hand the samples of each back to its own buffer
+	auto run = [&]() {
+		std::vector<int> labels;
+		std::vector<double> h;
+		std::vector<IsingCoupling> J;
+		double offset = 0.0;
+		for (auto& tile : tiles) {
+			int base = labels.size();
+			auto& p = tile.physical;
+			labels.insert(labels.end(), p.getLabels().begin(), p.getLabels().end());
+			h.insert(h.end(), p.getBiases().begin(), p.getBiases().end());
+			for (auto& c : p.getCouplings()) {
+				J.push_back( { base + c.i, base + c.j, c.value });
+			}
+			offset += p.getOffset();
+		}
+		IsingProblem problem(labels, h, J, offset);
+		xacc::info("Tiled Execution: " + std::to_string(tiles.size())
+				+ " problems on " + std::to_string(problem.size()) + " qubits");
+
+		auto params = getSamplerParameters(schedule);
+		auto sampler = getSampler();
+		auto samples = xacc::optionExists("dwave-adaptive-chunk-size") ?
+				sampleAdaptively(sampler, problem, params) :
+				sampler->sample(problem, params);
 
-		// Search the result for the status : COMPLETED indicator
-		if (boost::contains(msg, "COMPLETED")) {
-			jobCompleted = true;
+		for (auto& tile : tiles) {
+			auto tileSamples = HardwareTiler::select(samples, tile.physical.getLabels());
+			EnergyEvaluator(tile.physical, tileSamples.getLabels()).update(tileSamples);
+			storeSamples(tile.buffer, tileSamples, &tile.physical, &tile.logical);
 		}
+		tiles.clear();
+		tiler.reset();
+	};
 
-        if (boost::contains(msg, "FAILED")) {
-            Document d;
-            d.Parse(msg);
-            xacc::error("D-Wave Execution Failure: " + std::string(d["error_message"].GetString()));
-        }
-        
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        xacc::info(msg);
+	std::vector<std::shared_ptr<AcceleratorBuffer>> tmpBuffers;
+	for (std::size_t k = 0; k < functions.size(); k++) {
+		auto dwKernel = std::dynamic_pointer_cast<DWKernel>(functions[k]);
+		if (!dwKernel) {
+			xacc::error("Invalid kernel.");
+		}
+
+		// The problem graph, as the compiler embeds it
+		std::set<int> vertices;
+		for (auto inst : dwKernel->getInstructions()) {
+			if (inst->name() == "dw-qmi") {
+				vertices.insert(inst->bits()[0]);
+				vertices.insert(inst->bits()[1]);
+			}
+		}
+		if (vertices.empty()) {
+			xacc::error("Kernel " + dwKernel->name() + " has no dw-qmi instructions.");
+		}
+		auto problemGraph = std::make_shared<DWGraph>(*vertices.rbegin() + 1);
+		for (auto inst : dwKernel->getInstructions()) {
+			if (inst->name() == "dw-qmi") {
+				auto qbit1 = inst->bits()[0];
+				auto qbit2 = inst->bits()[1];
+				if (qbit1 == qbit2) {
+					problemGraph->setVertexProperties(qbit1, 1.0);
+				} else {
+					problemGraph->addEdge(qbit1, qbit2, 1.0);
+				}
+			}
+		}
+
+		auto embedding = embedTile(problemGraph, vertices);
+		if (embedding.empty() && !tiles.empty()) {
+			run();
+			embedding = embedTile(problemGraph, vertices);
+		}
+		if (embedding.empty()) {
+			xacc::error("Kernel " + dwKernel->name() + " does not fit on "
+					+ solver.name + ".");
+		}
+
+		auto tmpBuffer = createBuffer(buffer->name() + std::to_string(k),
+				buffer->size());
+		std::dynamic_pointer_cast<AQCAcceleratorBuffer>(tmpBuffer)->setEmbedding(
+				embedding);
+		tmpBuffers.push_back(tmpBuffer);
+
+		AnnealSchedule as;
+		auto newKernel = buildPhysicalKernel(tmpBuffer, {dwKernel}, as);
+		if (!tiles.empty() && as != schedule) {
+			xacc::error("Tiled kernels must share one anneal schedule.");
+		}
+		schedule = as;
+		tiles.push_back( { tmpBuffer, toIsingProblem(newKernel),
+				toIsingProblem(dwKernel) });
+	}
+	if (!tiles.empty()) {
+		run();
+	}
+
+	return tmpBuffers;
+}
+
+SampleSet DWAccelerator::sampleAdaptively(std::shared_ptr<DWSampler> sampler,
+		const IsingProblem& problem, const DWSamplerParameters& params) {
+
+	auto chunkSize = std::stoi(xacc::getOption("dwave-adaptive-chunk-size"));
+	double confidence = 0.99, tolerance = 0.0;
+	if (xacc::optionExists("dwave-adaptive-confidence")) {
+		confidence = std::stod(xacc::getOption("dwave-adaptive-confidence"));
+	}
+	if (xacc::optionExists("dwave-adaptive-tolerance")) {
+		tolerance = std::stod(xacc::getOption("dwave-adaptive-tolerance"));
+	}
+	if (chunkSize < 1 || confidence >= 1.0) {
+		xacc::error("Invalid adaptive sampling parameters.");
 	}
 
-	// We've completed, so let's get
-	// teh results.
-	doc.Parse(msg);
-	if (doc["status"] == "COMPLETED") {
-		std::vector<double> energies;
-		std::vector<int> numOccurrences, active_vars;
-		auto energyArray = doc["answer"]["energies"].GetArray();
-		auto numOccArray = doc["answer"]["num_occurrences"].GetArray();
-		for (int i = 0; i < energyArray.Size(); i++) {
-			energies.push_back(energyArray[i].GetDouble());
-			numOccurrences.push_back(numOccArray[i].GetInt());
+	// One chunk is kept in flight while the previous one is
+	// evaluated, except across MPI ranks, whose collectives
+	// run one at a time on the calling thread
+	auto policy = getLaunchPolicy();
+	std::size_t depth = policy == std::launch::deferred ? 1 : 2;
+
+	int submitted = 0, nChunks = 0;
+	auto launch = [&]() {
+		auto p = params;
+		p.numReads = std::min(chunkSize, params.numReads - submitted);
+		if (params.seed != 0) {
+			p.seed = SplitMix64(params.seed, nChunks).next() | 1;
 		}
+		submitted += p.numReads;
+		nChunks++;
+		return std::async(policy, [sampler, problem, p]() {
+			return sampler->sample(problem, p);
+		});
+	};
 
-		auto solutionsStrEncoded = std::string(doc["answer"]["solutions"].GetString());
-		auto decoded = base64_decode(solutionsStrEncoded);
-		std::string bitStr = "";
-		std::stringstream ss;
-		for (std::size_t i = 0; i < decoded.size(); ++i) {
-			ss << std::bitset<8>(decoded.c_str()[i]);
+	SamplingMonitor monitor(params.numReads, confidence, tolerance);
+	std::deque<std::future<SampleSet>> inFlight;
+	SampleSet samples;
+	inFlight.push_back(launch());
+	while (!inFlight.empty()) {
+		if (!monitor.isConverged() && submitted < params.numReads
+				&& inFlight.size() < depth) {
+			inFlight.push_back(launch());
 		}
 
-		bitStr = ss.str();
+		auto chunk = inFlight.front().get();
+		inFlight.pop_front();
+		monitor.update(chunk);
+		if (samples.getNumberOfVariables() == 0) {
+			samples = chunk;
+		} else {
+			samples.append(chunk);
+		}
 
-		auto activeVarsSize = doc["answer"]["active_variables"].GetArray().Size();
-		auto activeVars = doc["answer"]["active_variables"].GetArray();
-		for (int i = 0; i < activeVarsSize; i++) {
-			active_vars.push_back(activeVars[i].GetInt());
+		xacc::info("Adaptive Sampling: " + std::to_string(monitor.getNumberOfReads())
+				+ " reads, best energy " + std::to_string(monitor.getBestEnergy())
+				+ " at frequency " + std::to_string(monitor.getGroundStateFrequency())
+				+ ", mean energy " + std::to_string(monitor.getMeanEnergy())
+				+ " +/- " + std::to_string(monitor.getStandardError()));
+
+		if (!monitor.isConverged() && inFlight.empty() && submitted < params.numReads) {
+			inFlight.push_back(launch());
 		}
+	}
+
+	return samples;
+}
+
+void DWAccelerator::refine(std::shared_ptr<AcceleratorBuffer> buffer,
+		const std::shared_ptr<Function> function, const int maxIterations) {
+
+	auto dwBuffer = std::dynamic_pointer_cast<DWAcceleratorBuffer>(buffer);
+	if (!dwBuffer || dwBuffer->getSamples().size() == 0) {
+		xacc::error("Refinement needs a DWAcceleratorBuffer holding a previous result.");
+	}
 
-		auto nBitsPerMeasurementPadded = ((activeVarsSize + 8 - 1) / 8) * 8;
-		auto nPadBits = nBitsPerMeasurementPadded - activeVarsSize;
-		int counter = 0;
-		for (int i = 0; i < bitStr.size(); i += nBitsPerMeasurementPadded) {
-			auto subBuffer = bitStr.substr(i, nBitsPerMeasurementPadded);
-			boost::dynamic_bitset<> bset(subBuffer.substr(0, activeVarsSize));
-			counter++;
-			aqcBuffer->appendMeasurement(bset);
+	AnnealSchedule as;
+	auto newKernel = buildPhysicalKernel(buffer, {function}, as);
+	if (as.empty() || as.front().second != 1.0) {
+		xacc::error("Refinement needs a reverse anneal, anneal ta tp tq reverse.");
+	}
+	auto problem = toIsingProblem(newKernel);
+	auto logical = toIsingProblem(std::dynamic_pointer_cast<DWKernel>(function));
+	auto params = getSamplerParameters(as);
+	auto sampler = getSampler();
+	if (!sampler->supportsInitialState()) {
+		xacc::error("Refinement needs a sampler that starts reverse anneals "
+				"from an initial state, " + sampler->name() + " does not.");
+	}
+	auto embedding = dwBuffer->getEmbedding();
+
+	auto policy = getLaunchPolicy();
+	auto launch = [&](const std::vector<std::int8_t>& state) {
+		auto p = params;
+		p.initialState = state;
+		return std::async(policy, [sampler, problem, p]() {
+			return sampler->sample(problem, p);
+		});
+	};
+
+	// Every round is kept with the previous result, so the
+	// buffer ends up holding the best samples found
+	auto previous = dwBuffer->getSampleIndex().getLowestEnergy(1)[0];
+	auto state = getRefinementState(problem, dwBuffer->getSamples(), previous,
+			embedding);
+	auto bestEnergy = problem.energy(state.data());
+	auto running = launch(state);
+	SampleSet accumulated;
+
+	for (int iteration = 1; running.valid(); iteration++) {
+		auto samples = running.get();
+
+		// Submit the next round before keeping this one
+		int lowest = 0;
+		for (int i = 1; i < samples.size(); i++) {
+			if (samples.getEnergies()[i] < samples.getEnergies()[lowest]) {
+				lowest = i;
+			}
 		}
+		state = getRefinementState(problem, samples, lowest, embedding);
+		auto energy = problem.energy(state.data());
+		bool improved = energy < bestEnergy - 1e-9 * std::max(1.0, std::fabs(bestEnergy));
+		bestEnergy = std::min(bestEnergy, energy);
+		if (improved && iteration < maxIterations) {
+			running = launch(state);
+		}
+
+		xacc::info("Reverse Anneal Refinement " + std::to_string(iteration)
+				+ ": Energy " + std::to_string(energy));
 
-		aqcBuffer->setEnergies(energies);
-		aqcBuffer->setNumberOfOccurrences(numOccurrences);
-		aqcBuffer->setActiveVariableIndices(active_vars);
+		// Score this round against the physical problem
+		// and keep it while the next one anneals
+		EnergyEvaluator evaluator(problem, samples.getLabels());
+		if (accumulated.getNumberOfVariables() == 0) {
+			accumulated = HardwareTiler::select(dwBuffer->getSamples(),
+					samples.getLabels());
+			evaluator.update(accumulated);
+		}
+		evaluator.update(samples);
+		accumulated.append(samples);
+	}
 
-		std::cout << "NExecs: " << aqcBuffer->getNumberOfExecutions() << "\n";
+	// Store everything in place of the previous result in one go
+	buffer->resetBuffer();
+	dwBuffer->setEmbedding(embedding);
+	storeSamples(buffer, accumulated, &problem, &logical);
+}
+
+std::launch DWAccelerator::getLaunchPolicy() {
+#ifdef XACC_DWAVE_HAS_MPI
+	if (isLocalSampler() && DWDistributedSampler::isDistributed()) {
+		return std::launch::deferred;
+	}
+#endif
+	return std::launch::async;
+}
+
+std::vector<std::int8_t> DWAccelerator::getRefinementState(
+		const IsingProblem& problem, const SampleSet& samples, const int sample,
+		const Embedding& embedding) {
+
+	std::map<int, int> index;
+	for (int i = 0; i < problem.size(); i++) {
+		index[problem.getLabels()[i]] = i;
+	}
+
+	std::vector<std::int8_t> state(problem.size(), -1);
+	auto& labels = samples.getLabels();
+	for (int k = 0; k < samples.getNumberOfVariables(); k++) {
+		auto i = index.find(labels[k]);
+		if (i != index.end()) {
+			state[i->second] = samples.getSpin(sample, k);
+		}
+	}
+
+	for (auto& kv : embedding) {
+		int sum = 0;
+		std::vector<int> chain;
+		for (auto q : kv.second) {
+			auto i = index.find(q);
+			if (i != index.end()) {
+				chain.push_back(i->second);
+				sum += state[i->second];
+			}
+		}
+		for (auto i : chain) {
+			state[i] = sum >= 0 ? 1 : -1;
+		}
+	}
+
+	return state;
+}
+
+DWAnnealTuner::Objective DWAccelerator::getTuningObjective(
+		std::shared_ptr<AcceleratorBuffer> buffer,
+		const std::shared_ptr<Function> function) {
+
+	AnnealSchedule as;
+	auto newKernel = buildPhysicalKernel(buffer, {function}, as);
+	auto problem = toIsingProblem(newKernel);
+	auto params = getSamplerParameters(as);
+	auto sampler = getSampler();
+
+	// Reverse candidates start from the lowest energy
+	// sample of the buffer's previous result, if any
+	std::vector<std::int8_t> initialState;
+	auto dwBuffer = std::dynamic_pointer_cast<DWAcceleratorBuffer>(buffer);
+	if (dwBuffer && dwBuffer->getSamples().size() > 0
+			&& sampler->supportsInitialState()) {
+		auto lowest = dwBuffer->getSampleIndex().getLowestEnergy(1)[0];
+		initialState = getRefinementState(problem, dwBuffer->getSamples(),
+				lowest, dwBuffer->getEmbedding());
+	}
+
+	return [problem, params, sampler, initialState](const AnnealSchedule& schedule,
+			const int numReads, const std::uint64_t seed) {
+		auto p = params;
+		p.schedule = schedule;
+		p.numReads = numReads;
+		if (seed != 0) {
+			p.seed = seed;
+		}
+		p.initialState.clear();
+		if (!schedule.empty() && schedule.front().second == 1.0) {
+			if (initialState.empty()) {
+				xacc::error("Tuning reverse anneals needs a sampler supporting "
+						"initial states and a DWAcceleratorBuffer holding a previous result.");
+			}
+			p.initialState = initialState;
+		}
+		return sampler->sample(problem, p);
+	};
+}
+
+DWSamplerParameters DWAccelerator::getSamplerParameters(
+		const AnnealSchedule& schedule) {
+	DWSamplerParameters params;
+	params.schedule = schedule;
+	if (xacc::optionExists("dwave-num-reads")) {
+		params.numReads = std::stoi(xacc::getOption("dwave-num-reads"));
+	}
+	if (xacc::optionExists("dwave-seed")) {
+		params.seed = std::stoull(xacc::getOption("dwave-seed"));
+	}
+
+	AnnealScheduleGenerator gen;
+	xacc::info("Annealing Schedule: " + gen.getAsString(params.schedule));
+	return params;
+}
+
+std::shared_ptr<DWSampler> DWAccelerator::getSampler() {
+	int nGauges = 1;
+	if (xacc::optionExists("dwave-num-spin-reversals")) {
+		nGauges = std::stoi(xacc::getOption("dwave-num-spin-reversals"));
+	}
+
+	if (isLocalSampler()) {
+		auto sampler = xacc::getService<DWSampler>(xacc::getOption("dwave-sampler"));
+		if (nGauges > 1) {
+			sampler = std::make_shared<DWGaugeSampler>(sampler, nGauges);
+		}
+#ifdef XACC_DWAVE_HAS_MPI
+		if (DWDistributedSampler::isDistributed()) {
+			return std::make_shared<DWDistributedSampler>(sampler);
+		}
+#endif
+		return sampler;
+	}
+	if (!remoteSampler) {
+		xacc::error("The D-Wave Accelerator has not been initialized.");
+	}
+	auto solver = getSolver();
+	remoteSampler->setSolver(solver);
+	std::shared_ptr<DWSampler> sampler = remoteSampler;
+
+	// Route each job to one of the candidate solvers, hedging on
+	// a second one if asked to, and split requests under the
+	// limits of them all
+	bool hedging = xacc::optionExists("dwave-hedge")
+			&& xacc::getOption("dwave-hedge") == "true";
+	if (xacc::optionExists("dwave-solvers") || hedging) {
+		auto candidates = getCandidateSolvers();
+		std::vector<std::shared_ptr<DWRemoteSampler>> samplers;
+		for (auto& candidate : candidates) {
+			auto candidateSampler = std::make_shared<DWRemoteSampler>(restClient,
+					url, headers);
+			candidateSampler->setSolver(candidate);
+			samplers.push_back(candidateSampler);
+			solver.maxReads = std::min(solver.maxReads, candidate.maxReads);
+			solver.maxRunDuration = std::min(solver.maxRunDuration,
+					candidate.maxRunDuration);
+			solver.readoutThermalization = std::max(solver.readoutThermalization,
+					candidate.readoutThermalization);
+		}
+		if (hedging) {
+			double quantile = 0.95;
+			if (xacc::optionExists("dwave-hedge-quantile")) {
+				quantile = std::stod(xacc::getOption("dwave-hedge-quantile"));
+			}
+			sampler = std::make_shared<DWHedgingSampler>(candidates, samplers,
+					solverStatistics, quantile);
+		} else {
+			sampler = std::make_shared<DWRoutingSampler>(candidates,
+					std::vector<std::shared_ptr<DWSampler>>(samplers.begin(),
+							samplers.end()), solverStatistics);
+		}
+	}
+
+	sampler = std::make_shared<DWSplitSampler>(
+			sampler, solver.maxReads, solver.maxRunDuration,
+			solver.readoutThermalization + DWSplitSampler::readoutTime);
+	if (nGauges > 1) {
+		sampler = std::make_shared<DWGaugeSampler>(sampler, nGauges);
+	}
+	return sampler;
+}
+
+void DWAccelerator::storeSamples(std::shared_ptr<AcceleratorBuffer> buffer,
+		const SampleSet& rawSamples, const IsingProblem* physical,
+		const IsingProblem* logical) {
+
+	auto aqcBuffer = std::dynamic_pointer_cast<AQCAcceleratorBuffer>(buffer);
+	if (!aqcBuffer) {
+		xacc::error("Invalid AcceleratorBuffer passed to DW Accelerator. Must be an AQCAcceleratorBuffer.");
+	}
+
+	// Merge duplicate reads first, so everything
+	// downstream works on distinct samples only
+	bool aggregating = !xacc::optionExists("dwave-aggregate-samples")
+			|| xacc::getOption("dwave-aggregate-samples") != "false";
+	auto samples = aggregating ? aggregate(rawSamples) : rawSamples;
+
+	// Store the samples over the active qubits, most
+	// significant bit first, as SAPI returns them
+	for (int i = 0; i < samples.size(); i++) {
+		aqcBuffer->appendMeasurement(samples.getBitset(i));
+	}
+
+	auto energies = samples.getEnergies();
+	auto numOccurrences = samples.getNumberOfOccurrences();
+	auto active_vars = samples.getLabels();
+	aqcBuffer->setEnergies(energies);
+	aqcBuffer->setNumberOfOccurrences(numOccurrences);
+	aqcBuffer->setActiveVariableIndices(active_vars);
+
+	// Keep the packed samples, and map them back to the
+	// logical variables when the buffer has an embedding
+	auto dwBuffer = std::dynamic_pointer_cast<DWAcceleratorBuffer>(buffer);
+	auto embedding = aqcBuffer->getEmbedding();
+	if (dwBuffer) {
+		dwBuffer->setSamples(samples);
+	}
+	if (dwBuffer && physical && xacc::optionExists("dwave-estimate-beta")
+			&& xacc::getOption("dwave-estimate-beta") == "true") {
+		TemperatureEstimator estimator(*physical, samples.getLabels());
+		dwBuffer->setEffectiveBeta(estimator.estimateBeta(samples));
+		xacc::info("Effective Inverse Temperature: "
+				+ std::to_string(dwBuffer->getEffectiveBeta()));
+	}
+	if (dwBuffer && !embedding.empty()) {
+		auto method = ChainBreakMethod::MajorityVote;
+		if (xacc::optionExists("dwave-chain-break-method")) {
+			method = getChainBreakMethod(xacc::getOption("dwave-chain-break-method"));
+		}
+		std::uint64_t seed = 0;
+		if (xacc::optionExists("dwave-seed")) {
+			seed = std::stoull(xacc::getOption("dwave-seed"));
+		}
+
+		Unembedder unembedder(embedding, samples.getLabels());
+		auto logicalSamples = unembedder.unembed(samples, method, logical, seed);
+		if (aggregating) {
+			logicalSamples = aggregate(logicalSamples);
+		}
+
+		// Descend the logical samples to local minima, or polish them
+		// with tabu search, if asked to. They are not aggregated
+		// again, so each keeps its improvement.
+		std::vector<double> improvements;
+		if (xacc::optionExists("dwave-post-process")) {
+			auto postProcess = xacc::getOption("dwave-post-process");
+			if (postProcess == "steepest-descent" && logical) {
+				SteepestDescent descent(*logical, logicalSamples.getLabels());
+				logicalSamples = descent.descend(logicalSamples);
+				improvements = descent.getImprovements();
+				double mean = 0.0;
+				for (auto d : improvements) mean += d / improvements.size();
+				xacc::info("Mean Steepest Descent Improvement: " + std::to_string(mean));
+			} else if (postProcess == "tabu" && logical) {
+				auto polished = xacc::getService<DWSampler>("tabu")->polish(
+						*logical, logicalSamples);
+				double mean = 0.0;
+				for (int i = 0; i < polished.size(); i++) {
+					improvements.push_back(logicalSamples.getEnergies()[i]
+							- polished.getEnergies()[i]);
+					mean += improvements.back() / polished.size();
+				}
+				logicalSamples = polished;
+				xacc::info("Mean Tabu Improvement: " + std::to_string(mean));
+			} else if (postProcess != "none" && postProcess != "steepest-descent"
+					&& postProcess != "tabu") {
+				xacc::error("Invalid dwave-post-process " + postProcess
+						+ ", must be none, steepest-descent or tabu.");
+			}
+		}
+
+		dwBuffer->setLogicalSamples(logicalSamples,
+				unembedder.getSampleChainBreakFractions(),
+				unembedder.getChainBreakFractions());
+		dwBuffer->setImprovements(improvements);
+
+		auto& fractions = unembedder.getSampleChainBreakFractions();
+		double meanFraction = 0.0, nReads = 0.0;
+		for (int i = 0; i < samples.size(); i++) {
+			meanFraction += fractions[i] * samples.getNumberOfOccurrences()[i];
+			nReads += samples.getNumberOfOccurrences()[i];
+		}
+		meanFraction /= std::max(nReads, 1.0);
+		xacc::info("Mean Chain Break Fraction: " + std::to_string(meanFraction)
+				+ ", Logical Samples: " + std::to_string(logicalSamples.size()));
+	}
+
+	std::cout << "NExecs: " << aqcBuffer->getNumberOfExecutions() << "\n";
+	if (!dwBuffer) {
 		std::cout << "Min Meas: " << aqcBuffer->getLowestEnergy() << ", " << aqcBuffer->getLowestEnergyMeasurement() << "\n";
 		std::cout << "Max Prob Meas: " << aqcBuffer->getMostProbableEnergy() << ", " << aqcBuffer->getMostProbableMeasurement() << "\n";
+	} else if (samples.size() > 0) {
+		// The index is kept by the buffer for later queries
+		auto& index = dwBuffer->getSampleIndex();
+		auto lowest = index.getLowestEnergy(1)[0];
+		auto mostProbable = index.getMostFrequent(1)[0];
+		std::cout << "Min Meas: " << samples.getEnergies()[lowest] << ", " << samples.getBitset(lowest) << "\n";
+		std::cout << "Max Prob Meas: " << samples.getEnergies()[mostProbable] << ", " << samples.getBitset(mostProbable) << "\n";
+	}
+}
 
-	} else {
-		xacc::error("Error in executing D-Wave QPU.");
+IsingProblem DWAccelerator::toIsingProblem(std::shared_ptr<DWKernel> kernel) {
+
+	// Collect the qubits used by the kernel, in increasing
+	// order, and index them compactly
+	std::map<int, int> qubitToIndex;
+	for (auto inst : kernel->getInstructions()) {
+		if (inst->name() == "dw-qmi") {
+			qubitToIndex.insert(std::make_pair(inst->bits()[0], 0));
+			qubitToIndex.insert(std::make_pair(inst->bits()[1], 0));
+		}
+	}
+
+	std::vector<int> labels;
+	for (auto& kv : qubitToIndex) {
+		kv.second = labels.size();
+		labels.push_back(kv.first);
+	}
+
+	std::vector<double> h(labels.size(), 0.0);
+	std::vector<IsingCoupling> J;
+	for (auto inst : kernel->getInstructions()) {
+		if (inst->name() == "dw-qmi") {
+			auto i = qubitToIndex[inst->bits()[0]];
+			auto j = qubitToIndex[inst->bits()[1]];
+			double weightOrBias = boost::get<double>(inst->getParameter(0));
+			if (i == j) {
+				h[i] += weightOrBias;
+			} else {
+				J.push_back( { i, j, weightOrBias });
+			}
+		}
+	}
+
+	if (xacc::optionExists("dwave-solve-type")
+			&& xacc::getOption("dwave-solve-type") == "qubo") {
+		return IsingProblem::fromQUBO(labels, h, J);
+	}
+
+	return IsingProblem(labels, h, J);
+}
+
+bool DWAccelerator::isLocalSampler() {
+	return xacc::optionExists("dwave-sampler")
+			&& xacc::getOption("dwave-sampler") != "remote";
+}
+
+DWSolver DWAccelerator::getSolver() {
+	std::string solverName = "DW_2000Q_VFYC_2";
+	if (xacc::optionExists("dwave-solver")) {
+		solverName = xacc::getOption("dwave-solver");
+	}
+
+	if (!availableSolvers.count(solverName)) {
+		xacc::error(solverName + " is not available.");
 	}
 
+	return availableSolvers[solverName];
+}
+
+std::vector<DWSolver> DWAccelerator::getCandidateSolvers() {
+
+	// Route on current loads, fetching them again once stale
+	double refreshInterval = 30.0;
+	if (xacc::optionExists("dwave-solvers-refresh")) {
+		refreshInterval = std::stod(xacc::getOption("dwave-solvers-refresh"));
+	}
+	std::chrono::duration<double> age = std::chrono::steady_clock::now()
+			- solversFetched;
+	if (remoteSampler && age.count() > refreshInterval) {
+		fetchSolvers();
+	}
+
+	auto names = xacc::optionExists("dwave-solvers") ?
+			xacc::getOption("dwave-solvers") : "all";
+	std::vector<DWSolver> candidates;
+	if (names == "all") {
+		for (auto& kv : availableSolvers) {
+			candidates.push_back(kv.second);
+		}
+		return candidates;
+	}
+
+	std::vector<std::string> split;
+	boost::split(split, names, boost::is_any_of(","));
+	for (auto name : split) {
+		boost::trim(name);
+		if (!availableSolvers.count(name)) {
+			xacc::error(name + " is not available.");
+		}
+		candidates.push_back(availableSolvers[name]);
+	}
+	return candidates;
+}
+
+DWSolver DWAccelerator::makeChimeraSolver(const std::string& name,
+		const int m, const int n, const int t) {
+	DWSolver solver;
+	solver.name = name;
+	solver.description = "Local emulation of a C" + std::to_string(m)
+			+ " Chimera solver.";
+	solver.jRangeMin = -1.0;
+	solver.jRangeMax = 1.0;
+	solver.hRangeMin = -2.0;
+	solver.hRangeMax = 2.0;
+	solver.nQubits = 2 * m * n * t;
+
+	// Qubit (i, j, u, k) is shore u, index k of the cell in
+	// row i and column j. Shores are fully coupled inside a cell,
+	// shore 0 couples vertically and shore 1 horizontally.
+	auto qubit = [&](int i, int j, int u, int k) {
+		return ((i * n + j) * 2 + u) * t + k;
+	};
+	for (int i = 0; i < m; i++) {
+		for (int j = 0; j < n; j++) {
+			for (int k = 0; k < t; k++) {
+				for (int l = 0; l < t; l++) {
+					solver.edges.push_back(
+							std::make_pair(qubit(i, j, 0, k), qubit(i, j, 1, l)));
+				}
+				if (i + 1 < m) {
+					solver.edges.push_back(
+							std::make_pair(qubit(i, j, 0, k), qubit(i + 1, j, 0, k)));
+				}
+				if (j + 1 < n) {
+					solver.edges.push_back(
+							std::make_pair(qubit(i, j, 1, k), qubit(i, j + 1, 1, k)));
+				}
+			}
+		}
+	}
+
+	return solver;
+}
+
+std::vector<std::shared_ptr<AcceleratorBuffer>> DWAccelerator::processResponse(
+                std::shared_ptr<AcceleratorBuffer> buffer,
+                const std::string& response) {
+
+	if (!remoteSampler) {
+		xacc::error("The D-Wave Accelerator has not been initialized.");
+	}
+	storeSamples(buffer, remoteSampler->getSamples(response, remoteOffset),
+			remotePhysicalProblem.get(), remoteLogicalProblem.get());
+
 	return std::vector<std::shared_ptr<AcceleratorBuffer>> {buffer};
 }
 
@@ -396,17 +1102,7 @@ void DWAccelerator::findApiKeyInFile(std::string& apiKey, std::string& url,
  * @return connectivityGraph The graph structure of this Accelerator
  */
 std::shared_ptr<AcceleratorGraph> DWAccelerator::getAcceleratorConnectivity() {
-	std::string solverName = "DW_2000Q_VFYC_2";
-
-	if (xacc::optionExists("dwave-solver")) {
-		solverName = xacc::getOption("dwave-solver");
-	}
-
-	if (!availableSolvers.count(solverName)) {
-		xacc::error(solverName + " is not available.");
-	}
-
-	auto solver = availableSolvers[solverName];
+	auto solver = getSolver();
 
 	auto graph = std::make_shared<AcceleratorGraph>(solver.nQubits);
 
@@ -31,12 +31,18 @@
 #ifndef QUANTUM_GATE_ACCELERATORS_DWACCELERATOR_HPP_
 #define QUANTUM_GATE_ACCELERATORS_DWACCELERATOR_HPP_
 
+#include <chrono>
+#include <future>
 #include "RemoteAccelerator.hpp"
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include "DWKernel.hpp"
 #include "DWQMI.hpp"
 #include "AQCAcceleratorBuffer.hpp"
+#include "DWAcceleratorBuffer.hpp"
+#include "DWRemoteSampler.hpp"
+#include "DWSolverStatistics.hpp"
+#include "DWAnnealTuner.hpp"
 
 #define RAPIDJSON_HAS_STDSTRING 1
 
@@ -49,21 +55,6 @@ using namespace xacc;
 namespace xacc {
 namespace quantum {
 
-/**
- * Wrapper for information related to the remote
- * D-Wave solver.
- */
-struct DWSolver {
-	std::string name;
-	std::string description;
-	double jRangeMin;
-	double jRangeMax;
-	double hRangeMin;
-	double hRangeMax;
-	int nQubits;
-	std::vector<std::pair<int,int>> edges;
-};
-
 class AnnealScheduleGenerator {
     public:
     std::vector<std::pair<double,double>> generate(std::shared_ptr<Anneal> annealInst) {
@@ -173,15 +164,74 @@ public:
 			std::shared_ptr<AcceleratorBuffer> buffer,
 			const std::string& response);
 
+	/**
+	 * Execute the given kernel. The kernel is mapped onto the
+	 * solver and the physical problem is handed to the DWSampler
+	 * named by --dwave-sampler, the remote D-Wave solver by default.
+	 *
+	 * @param buffer The AQCAcceleratorBuffer to store results in
+	 * @param function The kernel to execute
+	 */
+	virtual void execute(std::shared_ptr<AcceleratorBuffer> buffer,
+			const std::shared_ptr<Function> function);
+
+	/**
+	 * Refine the last result in the buffer with reverse anneals of
+	 * the given kernel, which must have a reverse anneal instruction.
+	 * Each round starts from the lowest energy sample of the previous
+	 * one, with its broken chains set to their majority value through
+	 * the embedding, and rounds stop once the energy of that state
+	 * stops improving or after maxIterations. Rounds run one after
+	 * the other, as each starts from the last one's result, but a
+	 * round is submitted as soon as its initial state is known, and
+	 * the previous round is rescored and kept while it anneals. The
+	 * buffer's result is then replaced
+	 * by the previous samples together with those of every round, so
+	 * it holds the lowest energy found. The sampler must support
+	 * initial states.
+	 *
+	 * @param buffer The DWAcceleratorBuffer holding the previous result
+	 * @param function The kernel with a reverse anneal instruction
+	 * @param maxIterations The largest number of reverse anneals
+	 */
+	void refine(std::shared_ptr<AcceleratorBuffer> buffer,
+			const std::shared_ptr<Function> function,
+			const int maxIterations = 10);
+
+	/**
+	 * Return a DWAnnealTuner objective that runs the given kernel,
+	 * mapped onto the solver once, with the DWSampler named by
+	 * --dwave-sampler. Energies are those of the physical problem.
+	 * Reverse anneal candidates start from the lowest energy sample
+	 * of the buffer's previous result, as refine does, so tuning them
+	 * needs a DWAcceleratorBuffer holding one and a sampler that
+	 * supports initial states.
+	 *
+	 * @param buffer The AQCAcceleratorBuffer holding the embedding
+	 * @param function The kernel to tune
+	 * @return objective The tuning objective
+	 */
+	DWAnnealTuner::Objective getTuningObjective(
+			std::shared_ptr<AcceleratorBuffer> buffer,
+			const std::shared_ptr<Function> function);
+
+	/**
+	 * Execute the given kernels, each into a new buffer. With
+	 * --dwave-tile true the kernels are tiled onto disjoint regions
+	 * of the solver and run together, see executeTiled.
+	 */
 	virtual std::vector<std::shared_ptr<AcceleratorBuffer>> execute(
 			std::shared_ptr<AcceleratorBuffer> buffer,
 			const std::vector<std::shared_ptr<Function>> functions) {
+		if (xacc::optionExists("dwave-tile") && xacc::getOption("dwave-tile") == "true") {
+			return executeTiled(buffer, functions);
+		}
 		int counter = 0;
 		std::vector<std::shared_ptr<AcceleratorBuffer>> tmpBuffers;
 		for (auto f : functions) {
 			auto tmpBuffer = createBuffer(
 					buffer->name() + std::to_string(counter), buffer->size());
-			RemoteAccelerator::execute(tmpBuffer, f);
+			execute(tmpBuffer, f);
 			tmpBuffers.push_back(tmpBuffer);
 			counter++;
 		}
@@ -189,6 +239,23 @@ public:
 		return tmpBuffers;
 	}
 
+	/**
+	 * Execute the given kernels side by side. Each kernel is embedded
+	 * with --dwave-embedding onto its own region of the solver, handed
+	 * out by a HardwareTiler, and as many kernels as fit are run as one
+	 * physical problem. The samples are split back per kernel, scored
+	 * against its own physical problem, and stored in a new buffer
+	 * holding its embedding. Kernels that no longer fit start the next
+	 * physical problem. All kernels must share one anneal schedule.
+	 *
+	 * @param buffer The buffer naming the new buffers
+	 * @param functions The kernels to execute, copies allowed
+	 * @return buffers One buffer per kernel, in order
+	 */
+	std::vector<std::shared_ptr<AcceleratorBuffer>> executeTiled(
+			std::shared_ptr<AcceleratorBuffer> buffer,
+			const std::vector<std::shared_ptr<Function>> functions);
+
 
 	/**
 	 * This Accelerator models QPU Gate accelerators.
@@ -227,7 +294,24 @@ public:
 				("dwave-anneal-time", value<std::string>(), "The time to evolve the chip - an integer in microseconds.")
 				("dwave-thermalization", value<std::string>(), "The thermalization...")
 				("dwave-list-solvers", "List the available solvers at the Qubist URL.")
-                ("dwave-solve-type", value<std::string>(), "The solve type, qubo or ising");
+                ("dwave-solve-type", value<std::string>(), "The solve type, qubo or ising")
+				("dwave-sampler", value<std::string>(), "The name of the DWSampler to run the problem with, remote (the D-Wave QPU, default) or a local sampler.")
+				("dwave-list-samplers", "List all available samplers.")
+				("dwave-num-threads", value<std::string>(), "The number of threads local samplers may use.")
+				("dwave-seed", value<std::string>(), "The seed for local samplers.")
+				("dwave-aggregate-samples", value<std::string>(), "Merge duplicate samples and sort them by energy, true (default) or false.")
+				("dwave-post-process", value<std::string>(), "Post-process logical samples, none (default), steepest-descent or tabu.")
+				("dwave-num-spin-reversals", value<std::string>(), "The number of random spin-reversal transforms to split the reads among, default 1 (none).")
+				("dwave-adaptive-chunk-size", value<std::string>(), "Sample in chunks of this many reads until converged, with dwave-num-reads as the budget.")
+				("dwave-adaptive-confidence", value<std::string>(), "The confidence of having seen the lowest energy to stop adaptive sampling at, default 0.99, 0 for none.")
+				("dwave-adaptive-tolerance", value<std::string>(), "The standard error of the mean energy to stop adaptive sampling at, default 0 (none).")
+				("dwave-solvers", value<std::string>(), "Route each remote job to the least busy of these comma separated solvers, or all, that fits the problem.")
+				("dwave-solvers-refresh", value<std::string>(), "The age in seconds after which the solver loads jobs are routed by are fetched again, default 30.")
+				("dwave-hedge", value<std::string>(), "Resubmit remote jobs still queued at a deadline to a second solver, keeping the first answer, true or false (default).")
+				("dwave-hedge-quantile", value<std::string>(), "The quantile of the recent queue waits of a solver used as the hedging deadline, default 0.95.")
+				("dwave-tile", value<std::string>(), "Run the kernels of one execute call side by side on disjoint regions of the solver, true or false (default).")
+				("dwave-estimate-beta", value<std::string>(), "Fit the effective inverse temperature of the physical samples by pseudo-likelihood, true or false (default).")
+				("dwave-chain-break-method", value<std::string>(), "How broken chains are resolved when unembedding, majority-vote (default), discard, weighted-random or minimize-energy.");
 		return desc;
 	}
 
@@ -240,6 +324,14 @@ public:
 			}
 			return true;
 		}
+		if (map.count("dwave-list-samplers")) {
+			xacc::info("Registered D-Wave Sampler: remote");
+			auto ids = xacc::getRegisteredIds<DWSampler>();
+			for (auto i : ids) {
+				xacc::info("Registered D-Wave Sampler: " + i);
+			}
+			return true;
+		}
 		return false;
 	}
 
@@ -259,6 +351,25 @@ public:
 	virtual std::shared_ptr<AcceleratorBuffer> createBuffer(
 				const std::string& varId);
 
+	/**
+	 * Return the Ising problem described by the given logical or
+	 * physical kernel, over the qubits it uses. QUBO kernels are
+	 * converted when the solve type is qubo. Together with the
+	 * EnergyEvaluator this scores whole SampleSets against a kernel.
+	 *
+	 * @param kernel The kernel
+	 * @return problem The Ising problem
+	 */
+	static IsingProblem toIsingProblem(std::shared_ptr<DWKernel> kernel);
+
+	/**
+	 * Return the per-solver latencies and the hedging
+	 * metrics of the remote jobs run so far.
+	 */
+	std::shared_ptr<DWSolverStatistics> getSolverStatistics() {
+		return solverStatistics;
+	}
+
 	virtual const std::string name() const {
 		return "dwave";
 	}
@@ -304,6 +415,161 @@ protected:
 	 */
 	void findApiKeyInFile(std::string& key, std::string& url, boost::filesystem::path &p);
 
+	/**
+	 * The sampler posting problems to the remote solvers,
+	 * created once SAPI credentials are known.
+	 */
+	std::shared_ptr<DWRemoteSampler> remoteSampler;
+
+	/**
+	 * The energy offset of the last problem built by
+	 * processInput, added back in processResponse.
+	 */
+	double remoteOffset = 0.0;
+
+	/**
+	 * The physical problem of the last kernel processInput
+	 * was called with, used to fit the effective temperature.
+	 */
+	std::shared_ptr<IsingProblem> remotePhysicalProblem;
+
+	/**
+	 * The logical problem of the last kernel processInput
+	 * was called with, used to unembed its response.
+	 */
+	std::shared_ptr<IsingProblem> remoteLogicalProblem;
+
+	/**
+	 * The latencies of the remote jobs of this accelerator,
+	 * per solver, kept across executions to route jobs by.
+	 */
+	std::shared_ptr<DWSolverStatistics> solverStatistics =
+			std::make_shared<DWSolverStatistics>();
+
+	/**
+	 * When the solver list was last fetched from SAPI.
+	 */
+	std::chrono::steady_clock::time_point solversFetched;
+
+	/**
+	 * Fetch the remote solvers, their properties and
+	 * current loads, into availableSolvers.
+	 */
+	void fetchSolvers();
+
+	/**
+	 * Return the solvers named by --dwave-solvers, a comma separated
+	 * list, or every available solver for all or when it is not set.
+	 * The solver list, and so the loads jobs are routed by, is fetched
+	 * again first once older than --dwave-solvers-refresh seconds,
+	 * 30 by default. Each execution routes on the loads of its start.
+	 */
+	std::vector<DWSolver> getCandidateSolvers();
+
+	/**
+	 * Return true if --dwave-sampler names a local sampler.
+	 */
+	bool isLocalSampler();
+
+	/**
+	 * Return the solver named by --dwave-solver.
+	 */
+	DWSolver getSolver();
+
+	/**
+	 * Return the DWSampler named by --dwave-sampler, or
+	 * the remote sampler set up for the current solver, splitting
+	 * requests over the solver's read and run time limits into
+	 * several jobs. With --dwave-solvers each job is routed to the
+	 * fitting candidate solver with the shortest estimated wait by a
+	 * DWRoutingSampler, and with --dwave-hedge true jobs still queued
+	 * at a deadline are also sent to the next best solver by a
+	 * DWHedgingSampler. Either runs --dwave-num-spin-reversals gauges of
+	 * the problem if given. Local samplers are distributed over MPI
+	 * ranks when built with MPI and run with more than one rank,
+	 * each rank drawing its own gauges.
+	 */
+	std::shared_ptr<DWSampler> getSampler();
+
+	/**
+	 * Sample the problem in chunks of --dwave-adaptive-chunk-size
+	 * reads until a SamplingMonitor with --dwave-adaptive-confidence
+	 * and --dwave-adaptive-tolerance is converged, or numReads reads
+	 * are spent. The next chunk is submitted while the current one
+	 * is in flight, and a chunk in flight at convergence is kept.
+	 *
+	 * @param sampler The sampler to run the chunks with
+	 * @param problem The physical problem
+	 * @param params The parameters, numReads being the budget
+	 * @return samples The samples of all chunks
+	 */
+	SampleSet sampleAdaptively(std::shared_ptr<DWSampler> sampler,
+			const IsingProblem& problem, const DWSamplerParameters& params);
+
+	/**
+	 * Return std::launch::async, or std::launch::deferred when local
+	 * samples are distributed over MPI ranks, so their collectives
+	 * run on the calling thread, in the same order on every rank.
+	 */
+	std::launch getLaunchPolicy();
+
+	/**
+	 * Return the spins of the given sample over the variables of the
+	 * problem, -1 for those not sampled, with every chain of the
+	 * embedding set to the majority value of its qubits.
+	 */
+	static std::vector<std::int8_t> getRefinementState(
+			const IsingProblem& problem, const SampleSet& samples,
+			const int sample, const Embedding& embedding);
+
+	/**
+	 * Return the sampler parameters set on the command line,
+	 * with the given anneal schedule.
+	 */
+	DWSamplerParameters getSamplerParameters(const AnnealSchedule& schedule);
+
+	/**
+	 * Store the given samples in the buffer as measurements over
+	 * the active qubits, with their energies and occurrences, and
+	 * print a summary. Duplicate samples are merged unless
+	 * --dwave-aggregate-samples is false. DWAcceleratorBuffers with an
+	 * embedding also get the samples unembedded with
+	 * --dwave-chain-break-method. The effective inverse temperature
+	 * of the samples is fitted if --dwave-estimate-beta is true.
+	 *
+	 * @param buffer The AQCAcceleratorBuffer to store results in
+	 * @param samples The samples
+	 * @param physical The physical problem the samples were drawn from
+	 * @param logical The logical problem, to score logical samples
+	 */
+	void storeSamples(std::shared_ptr<AcceleratorBuffer> buffer,
+			const SampleSet& samples, const IsingProblem* physical = nullptr,
+			const IsingProblem* logical = nullptr);
+
+	/**
+	 * Map the logical kernel onto the solver with the configured
+	 * ParameterSetter, returning the physical kernel and setting
+	 * the anneal schedule it should be run with.
+	 *
+	 * @param buffer The AQCAcceleratorBuffer holding the embedding
+	 * @param functions The kernel to map
+	 * @param schedule The anneal schedule to run
+	 * @return kernel The physical kernel
+	 */
+	std::shared_ptr<DWKernel> buildPhysicalKernel(
+			std::shared_ptr<AcceleratorBuffer> buffer,
+			std::vector<std::shared_ptr<Function>> functions,
+			AnnealSchedule& schedule);
+
+
+	/**
+	 * Return a solver with the Chimera topology of m x n unit
+	 * cells with t qubits per shore, used to emulate a remote
+	 * solver when running local samplers offline.
+	 */
+	static DWSolver makeChimeraSolver(const std::string& name, const int m,
+			const int n, const int t);
+
 };
 
 }
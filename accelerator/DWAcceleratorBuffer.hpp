@@ -0,0 +1,227 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWACCELERATORBUFFER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWACCELERATORBUFFER_HPP_
+
+#include "AQCAcceleratorBuffer.hpp"
+#include "SampleIndex.hpp"
+#include "SampleStatistics.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWAcceleratorBuffer is the AQCAcceleratorBuffer created by
+ * the DWAccelerator. Besides the physical measurements it keeps the
+ * packed physical samples, and the logical samples unembedded from
+ * them with the chain break statistics of the unembedding and the
+ * improvements of any post-processing, and the effective inverse
+ * temperature fitted to the physical samples. A SampleIndex over each set
+ * of samples is built on first use and kept until they change, so
+ * repeated top-k and quantile queries do not rescan the samples.
+ */
+class DWAcceleratorBuffer : public AQCAcceleratorBuffer {
+
+public:
+
+	DWAcceleratorBuffer(const std::string& str, const int N) :
+			AQCAcceleratorBuffer(str, N) {
+	}
+
+	/**
+	 * Set the physical samples, over the active qubits.
+	 */
+	void setSamples(const SampleSet& physicalSamples) {
+		samples = physicalSamples;
+		sampleIndex.reset();
+	}
+
+	/**
+	 * Return the physical samples, over the active qubits.
+	 */
+	const SampleSet& getSamples() const {
+		return samples;
+	}
+
+	/**
+	 * Return the index of the physical samples.
+	 */
+	SampleIndex& getSampleIndex() {
+		if (!sampleIndex) {
+			sampleIndex = std::make_shared<SampleIndex>(samples);
+		}
+		return *sampleIndex;
+	}
+
+	/**
+	 * Set the logical samples and the chain break statistics
+	 * of the unembedding that produced them.
+	 *
+	 * @param unembedded The samples over the logical variables
+	 * @param sampleFractions The fraction of broken chains per physical sample
+	 * @param chainFractions The fraction of reads each chain was broken in
+	 */
+	void setLogicalSamples(const SampleSet& unembedded,
+			const std::vector<double>& sampleFractions,
+			const std::vector<double>& chainFractions) {
+		logicalSamples = unembedded;
+		logicalSampleIndex.reset();
+		sampleChainBreakFractions = sampleFractions;
+		chainBreakFractions = chainFractions;
+	}
+
+	/**
+	 * Return the samples over the logical variables.
+	 */
+	const SampleSet& getLogicalSamples() const {
+		return logicalSamples;
+	}
+
+	/**
+	 * Return the index of the logical samples.
+	 */
+	SampleIndex& getLogicalSampleIndex() {
+		if (!logicalSampleIndex) {
+			logicalSampleIndex = std::make_shared<SampleIndex>(logicalSamples);
+		}
+		return *logicalSampleIndex;
+	}
+
+	/**
+	 * Return the fraction of broken chains in each physical sample.
+	 */
+	const std::vector<double>& getSampleChainBreakFractions() const {
+		return sampleChainBreakFractions;
+	}
+
+	/**
+	 * Return the fraction of reads in which each chain, in
+	 * getLogicalSamples() label order, was broken.
+	 */
+	const std::vector<double>& getChainBreakFractions() const {
+		return chainBreakFractions;
+	}
+
+	/**
+	 * Set the energy each logical sample was lowered
+	 * by in post-processing.
+	 */
+	void setImprovements(const std::vector<double>& energyImprovements) {
+		improvements = energyImprovements;
+	}
+
+	/**
+	 * Return the energy each logical sample was lowered by in
+	 * post-processing, empty if it was not post-processed.
+	 */
+	const std::vector<double>& getImprovements() const {
+		return improvements;
+	}
+
+	/**
+	 * Set the effective inverse temperature of the physical samples.
+	 */
+	void setEffectiveBeta(const double beta) {
+		effectiveBeta = beta;
+	}
+
+	/**
+	 * Return the effective inverse temperature of the physical
+	 * samples, in inverse units of the problem energy, or -1 if
+	 * it was not estimated.
+	 */
+	double getEffectiveBeta() const {
+		return effectiveBeta;
+	}
+
+	/**
+	 * Return the magnetization <s_i> of each variable, over the
+	 * physical samples or, if logical is true, the logical ones.
+	 */
+	std::vector<double> getMagnetizations(const bool logical = false) const {
+		return SampleStatistics(logical ? logicalSamples : samples).getMagnetizations();
+	}
+
+	/**
+	 * Return the correlation <s_i s_j> of each given pair of qubits,
+	 * or of logical variables if logical is true.
+	 */
+	std::vector<double> getCorrelations(const std::vector<std::pair<int, int>>& edges,
+			const bool logical = false) const {
+		return SampleStatistics(logical ? logicalSamples : samples).getCorrelations(edges);
+	}
+
+	/**
+	 * Return the correlation matrix <s_i s_j>, row major over the
+	 * labels of the physical samples, or the logical ones if logical
+	 * is true.
+	 */
+	std::vector<double> getCorrelationMatrix(const bool logical = false) const {
+		return SampleStatistics(logical ? logicalSamples : samples).getCorrelationMatrix();
+	}
+
+	virtual void resetBuffer() {
+		AQCAcceleratorBuffer::resetBuffer();
+		samples = SampleSet();
+		logicalSamples = SampleSet();
+		sampleChainBreakFractions.clear();
+		chainBreakFractions.clear();
+		improvements.clear();
+		effectiveBeta = -1.0;
+		sampleIndex.reset();
+		logicalSampleIndex.reset();
+	}
+
+	virtual ~DWAcceleratorBuffer() {}
+
+protected:
+
+	SampleSet samples;
+
+	SampleSet logicalSamples;
+
+	std::vector<double> sampleChainBreakFractions;
+
+	std::vector<double> chainBreakFractions;
+
+	std::vector<double> improvements;
+
+	double effectiveBeta = -1.0;
+
+	std::shared_ptr<SampleIndex> sampleIndex;
+
+	std::shared_ptr<SampleIndex> logicalSampleIndex;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,250 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include "DWAnnealTuner.hpp"
+#include "DWAccelerator.hpp"
+#include "DWDistributedSampler.hpp"
+#include "TimeToSolution.hpp"
+
+namespace xacc {
+namespace quantum {
+
+AnnealSchedule AnnealCandidate::getSchedule() const {
+	auto anneal = std::make_shared<Anneal>(std::vector<InstructionParameter> {
+			InstructionParameter(ta), InstructionParameter(tp),
+			InstructionParameter(tq), InstructionParameter(direction) });
+	AnnealScheduleGenerator gen;
+	return gen.generate(anneal);
+}
+
+void DWAnnealTuner::setDirections(const std::vector<std::string>& allowed) {
+	if (allowed.empty()) {
+		xacc::error("DWAnnealTuner: no anneal directions to search.");
+	}
+	for (auto& d : allowed) {
+		if (d != "forward" && d != "reverse") {
+			xacc::error("DWAnnealTuner: invalid anneal direction " + d + ".");
+		}
+	}
+	directions = allowed;
+}
+
+void DWAnnealTuner::setTimeRange(const double low, const double high) {
+	if (low <= 0.0 || high < low) {
+		xacc::error("DWAnnealTuner: invalid time range.");
+	}
+	minTime = low;
+	maxTime = high;
+}
+
+AnnealCandidate DWAnnealTuner::tune(const int nEvaluations) {
+	if (nEvaluations < 1) {
+		xacc::error("DWAnnealTuner: nothing to evaluate.");
+	}
+
+	candidates.clear();
+	results.clear();
+	if (!hasTarget) {
+		target = std::numeric_limits<double>::infinity();
+	}
+
+	// Finished evaluations are queued here by the tasks, which
+	// must all be done before these go out of scope, as the
+	// futures of std::async wait in their destructors.
+	std::mutex mutex;
+	std::condition_variable finishedOne;
+	std::deque<int> done;
+	std::vector<std::future<SampleSet>> futures;
+
+	struct Notifier {
+		std::mutex& mutex;
+		std::condition_variable& cv;
+		std::deque<int>& done;
+		int k;
+		~Notifier() {
+			std::lock_guard<std::mutex> lock(mutex);
+			done.push_back(k);
+			cv.notify_one();
+		}
+	};
+
+	// Across MPI ranks a local objective runs collectives, which
+	// concurrent evaluations could issue in a different order on
+	// each rank, so there candidates are evaluated one at a time
+	// on the calling thread
+	bool synchronous = nInFlight == 1;
+#ifdef XACC_DWAVE_HAS_MPI
+	synchronous = synchronous || DWDistributedSampler::isDistributed();
+#endif
+
+	SplitMix64 rng(seed, 0);
+	std::vector<int> finished;
+	int nRunning = 0;
+	while (static_cast<int>(finished.size()) < nEvaluations) {
+		SampleSet samples;
+		int k;
+		if (synchronous) {
+			k = candidates.size();
+			candidates.push_back(propose(k, finished, rng));
+			results.emplace_back();
+			auto evaluationSeed = seed == 0 ? 0 : SplitMix64(seed, k + 1).next();
+			samples = objective(candidates.back().getSchedule(), numReads,
+					evaluationSeed);
+		} else {
+			while (nRunning < nInFlight
+					&& static_cast<int>(candidates.size()) < nEvaluations) {
+				int j = candidates.size();
+				candidates.push_back(propose(j, finished, rng));
+				results.emplace_back();
+				auto schedule = candidates.back().getSchedule();
+				auto evaluationSeed = seed == 0 ? 0 : SplitMix64(seed, j + 1).next();
+				futures.push_back(std::async(std::launch::async,
+						[this, &mutex, &finishedOne, &done, schedule, evaluationSeed, j]() {
+							Notifier notifier {mutex, finishedOne, done, j};
+							return objective(schedule, numReads, evaluationSeed);
+						}));
+				nRunning++;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				finishedOne.wait(lock, [&]() {return !done.empty();});
+				k = done.front();
+				done.pop_front();
+			}
+			nRunning--;
+			samples = futures[k].get();
+		}
+		for (int i = 0; i < samples.size(); i++) {
+			results[k].push_back(std::make_pair(samples.getEnergies()[i],
+					samples.getNumberOfOccurrences()[i]));
+		}
+		finished.push_back(k);
+		rescore(finished);
+
+		auto& c = candidates[k];
+		xacc::info("Anneal Tuner: ta = " + std::to_string(c.ta) + ", tp = "
+				+ std::to_string(c.tp) + ", tq = " + std::to_string(c.tq) + ", "
+				+ c.direction + ", p = " + std::to_string(c.successProbability)
+				+ ", TTS99 = " + std::to_string(c.tts));
+	}
+
+	auto best = candidates[0];
+	for (auto& c : candidates) {
+		if (c.tts < best.tts) {
+			best = c;
+		}
+	}
+	return best;
+}
+
+AnnealCandidate DWAnnealTuner::propose(const int k,
+		const std::vector<int>& finished, SplitMix64& rng) {
+
+	auto clip = [&](double t) {
+		return std::min(maxTime, std::max(minTime, t));
+	};
+
+	// Start from forward anneals on a log-spaced grid
+	AnnealCandidate candidate;
+	candidate.direction = directions[0];
+	if (finished.empty()) {
+		auto ratio = std::min(maxTime / minTime, 100.0);
+		auto x = nInFlight > 1 ? double(k % nInFlight) / (nInFlight - 1) : 0.5;
+		candidate.ta = clip(minTime * std::pow(ratio, x));
+		return candidate;
+	}
+
+	// Perturb one of the three best candidates so far
+	std::vector<int> ranked(finished);
+	std::sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+		return candidates[a].tts < candidates[b].tts
+				|| (candidates[a].tts == candidates[b].tts
+						&& candidates[a].successProbability
+								> candidates[b].successProbability);
+	});
+	candidate = candidates[ranked[rng.next() % std::min<std::size_t>(3, ranked.size())]];
+
+	auto gaussian = [&]() {
+		auto u = std::max(rng.uniform(), 1e-300);
+		return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * rng.uniform());
+	};
+	auto perturb = [&](double& t) {
+		if (t == 0.0) {
+			if (rng.uniform() < 0.2) t = clip(candidate.ta * rng.uniform());
+		} else if (rng.uniform() < 0.1) {
+			t = 0.0;
+		} else {
+			t = clip(t * std::exp(0.5 * gaussian()));
+		}
+	};
+
+	candidate.ta = clip(candidate.ta * std::exp(0.5 * gaussian()));
+	perturb(candidate.tp);
+	perturb(candidate.tq);
+	if (directions.size() > 1 && rng.uniform() < 0.1) {
+		candidate.direction = directions[rng.next() % directions.size()];
+	}
+	candidate.successProbability = 0.0;
+	candidate.tts = std::numeric_limits<double>::infinity();
+	return candidate;
+}
+
+void DWAnnealTuner::rescore(const std::vector<int>& finished) {
+	if (!hasTarget) {
+		for (auto k : finished) {
+			for (auto& r : results[k]) {
+				target = std::min(target, r.first);
+			}
+		}
+	}
+
+	auto tolerance = 1e-6 * std::max(1.0, std::fabs(target));
+	for (auto k : finished) {
+		double successes = 0.0, reads = 0.0;
+		for (auto& r : results[k]) {
+			reads += r.second;
+			if (r.first <= target + tolerance) {
+				successes += r.second;
+			}
+		}
+		auto& c = candidates[k];
+		c.successProbability = reads > 0.0 ? successes / reads : 0.0;
+		c.tts = timeToSolution(c.successProbability, c.getSchedule().back().first);
+	}
+}
+
+}
+}
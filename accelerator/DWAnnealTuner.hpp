@@ -0,0 +1,188 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWANNEALTUNER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWANNEALTUNER_HPP_
+
+#include <functional>
+#include <limits>
+#include "DWSampler.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The parameters of an anneal instruction, ta tp tq direction,
+ * and the success probability and TTS99 they were measured at.
+ */
+struct AnnealCandidate {
+	double ta = 20.0;
+	double tp = 0.0;
+	double tq = 0.0;
+	std::string direction = "forward";
+	double successProbability = 0.0;
+	double tts = std::numeric_limits<double>::infinity();
+
+	/**
+	 * Return the schedule of this anneal instruction,
+	 * as the AnnealScheduleGenerator builds it.
+	 */
+	AnnealSchedule getSchedule() const;
+};
+
+/**
+ * The DWAnnealTuner searches the ta, tp, tq and direction of an
+ * anneal instruction for the lowest time to reach a target energy
+ * with 99% confidence, TTS99 = t ln(0.01) / ln(1 - p), with t the
+ * schedule length and p the fraction of reads at the target. The
+ * target is the given energy, or the lowest one seen so far, in
+ * which case every candidate is rescored when it improves.
+ *
+ * The objective runs one batch of reads of a schedule, on the QPU
+ * or a local sampler. Several candidates are kept in flight at
+ * once, each batch evaluated asynchronously, and whenever one
+ * finishes a new candidate is proposed from the best ones known at
+ * that time, by log-normal perturbations of the times and occasional
+ * pauses, quenches and direction changes. The first candidates are
+ * forward anneals on a log-spaced grid of anneal times. With one
+ * evaluation in flight, or across several MPI ranks, candidates are
+ * evaluated one at a time on the calling thread instead.
+ */
+class DWAnnealTuner {
+
+public:
+
+	/**
+	 * Run numReads reads of the given schedule with
+	 * the given seed and return the samples.
+	 */
+	using Objective = std::function<SampleSet(const AnnealSchedule&,
+			const int, const std::uint64_t)>;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param f The objective
+	 * @param reads The number of reads per evaluation
+	 * @param inFlight The number of concurrent evaluations
+	 * @param tunerSeed The seed for proposals and evaluations, random if 0
+	 */
+	DWAnnealTuner(Objective f, const int reads = 100, const int inFlight = 4,
+			const std::uint64_t tunerSeed = 0) :
+			objective(f), numReads(reads), nInFlight(std::max(1, inFlight)),
+			seed(tunerSeed) {
+	}
+
+	/**
+	 * Set the target energy. By default it is the
+	 * lowest energy seen over all evaluations.
+	 */
+	void setTargetEnergy(const double energy) {
+		target = energy;
+		hasTarget = true;
+	}
+
+	/**
+	 * Set the directions to search, forward and/or reverse.
+	 */
+	void setDirections(const std::vector<std::string>& allowed);
+
+	/**
+	 * Set the range of each of ta, tp and tq in microseconds,
+	 * tp and tq may also be 0.
+	 */
+	void setTimeRange(const double minTime, const double maxTime);
+
+	/**
+	 * Evaluate the given number of candidates and
+	 * return the one with the lowest TTS99.
+	 */
+	AnnealCandidate tune(const int nEvaluations);
+
+	/**
+	 * Return every evaluated candidate, scored
+	 * against the final target energy.
+	 */
+	const std::vector<AnnealCandidate>& getCandidates() const {
+		return candidates;
+	}
+
+	/**
+	 * Return the target energy the candidates are scored against.
+	 */
+	double getTargetEnergy() const {
+		return target;
+	}
+
+protected:
+
+	Objective objective;
+
+	int numReads;
+
+	int nInFlight;
+
+	std::uint64_t seed;
+
+	double target = std::numeric_limits<double>::infinity();
+
+	bool hasTarget = false;
+
+	std::vector<std::string> directions {"forward"};
+
+	double minTime = 1.0;
+
+	double maxTime = 2000.0;
+
+	std::vector<AnnealCandidate> candidates;
+
+	/**
+	 * The energies and occurrences each candidate returned.
+	 */
+	std::vector<std::vector<std::pair<double, int>>> results;
+
+	/**
+	 * Return the k-th candidate to evaluate,
+	 * given the finished and scored ones.
+	 */
+	AnnealCandidate propose(const int k, const std::vector<int>& finished,
+			SplitMix64& rng);
+
+	/**
+	 * Score the finished candidates against the target.
+	 */
+	void rescore(const std::vector<int>& finished);
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,154 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifdef XACC_DWAVE_HAS_MPI
+
+#include <cstdlib>
+#include <mpi.h>
+#include "DWDistributedSampler.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+namespace {
+
+void finalizeMPI() {
+	int finalized;
+	MPI_Finalized(&finalized);
+	if (!finalized) {
+		MPI_Finalize();
+	}
+}
+
+/**
+ * Return the displacements of the given
+ * counts, and set their total.
+ */
+std::vector<int> displacements(const std::vector<int>& counts, int& total) {
+	std::vector<int> displs(counts.size());
+	total = 0;
+	for (std::size_t r = 0; r < counts.size(); r++) {
+		displs[r] = total;
+		total += counts[r];
+	}
+	return displs;
+}
+
+}
+
+bool DWDistributedSampler::isDistributed() {
+	// Samplers may be called from a worker thread, one at a
+	// time, which needs at least MPI_THREAD_SERIALIZED
+	int initialized, provided;
+	MPI_Initialized(&initialized);
+	if (!initialized) {
+		MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &provided);
+		std::atexit(finalizeMPI);
+	} else {
+		MPI_Query_thread(&provided);
+	}
+	if (provided < MPI_THREAD_SERIALIZED) {
+		xacc::error("The D-Wave distributed sampler needs MPI initialized "
+				"with at least MPI_THREAD_SERIALIZED.");
+	}
+
+	int size;
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+	return size > 1;
+}
+
+SampleSet DWDistributedSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	// Every rank derives its stream from rank 0's seed, so a
+	// seeded run is reproducible for a given number of ranks
+	std::uint64_t seed = rank == 0 ? getSeed(params) : 0;
+	MPI_Bcast(&seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+	auto localParams = params;
+	localParams.numReads = params.numReads / size
+			+ (rank < params.numReads % size ? 1 : 0);
+	localParams.seed = SplitMix64(seed, rank).next() | 1;
+
+	auto local = localParams.numReads > 0 ?
+			sampler->sample(problem, localParams) :
+			SampleSet(problem.getLabels());
+
+	// Gather the sample counts, then the packed
+	// rows, energies and occurrences
+	int count = local.size();
+	std::vector<int> counts(size);
+	MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT,
+			MPI_COMM_WORLD);
+
+	int total, totalWords;
+	auto nWords = local.getWordsPerSample();
+	auto displs = displacements(counts, total);
+	std::vector<int> wordCounts(size);
+	for (int r = 0; r < size; r++) {
+		wordCounts[r] = counts[r] * nWords;
+	}
+	auto wordDispls = displacements(wordCounts, totalWords);
+
+	std::vector<std::uint64_t> words(count * nWords), allWords(totalWords);
+	for (int i = 0; i < count; i++) {
+		std::copy(local.getRow(i), local.getRow(i) + nWords, &words[i * nWords]);
+	}
+	std::vector<double> allEnergies(total);
+	std::vector<int> allOccurrences(total);
+
+	MPI_Allgatherv(words.data(), wordCounts[rank], MPI_UINT64_T, allWords.data(),
+			wordCounts.data(), wordDispls.data(), MPI_UINT64_T, MPI_COMM_WORLD);
+	MPI_Allgatherv(local.getEnergies().data(), count, MPI_DOUBLE,
+			allEnergies.data(), counts.data(), displs.data(), MPI_DOUBLE,
+			MPI_COMM_WORLD);
+	MPI_Allgatherv(local.getNumberOfOccurrences().data(), count, MPI_INT,
+			allOccurrences.data(), counts.data(), displs.data(), MPI_INT,
+			MPI_COMM_WORLD);
+
+	SampleSet samples(local.getLabels());
+	samples.reserve(total);
+	for (int i = 0; i < total; i++) {
+		samples.appendPacked(&allWords[i * nWords], allEnergies[i],
+				allOccurrences[i]);
+	}
+
+	return samples;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,104 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWDISTRIBUTEDSAMPLER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWDISTRIBUTEDSAMPLER_HPP_
+
+#ifdef XACC_DWAVE_HAS_MPI
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWDistributedSampler spreads the reads of a local DWSampler
+ * over the ranks of MPI_COMM_WORLD. Every rank runs the wrapped
+ * sampler on its share of the reads, with its own stream of the
+ * common seed, and the packed samples, energies and occurrences of
+ * all ranks are then all-gathered in rank order, so every rank's
+ * buffer ends up holding the whole run.
+ *
+ * MPI is initialized on first use with MPI_THREAD_SERIALIZED if
+ * the application has not done so already, and finalized at exit in
+ * that case. An application initializing MPI itself must provide at
+ * least that level. Its collectives run on MPI_COMM_WORLD, so calls
+ * must not overlap; the DWAccelerator samples on the calling thread
+ * whenever it is distributed.
+ */
+class DWDistributedSampler : public DWSampler {
+
+public:
+
+	/**
+	 * The constructor, takes the local sampler to distribute.
+	 */
+	DWDistributedSampler(std::shared_ptr<DWSampler> localSampler) :
+			sampler(localSampler) {
+	}
+
+	/**
+	 * Return true if this process is one of several MPI
+	 * ranks, initializing MPI if needed.
+	 */
+	static bool isDistributed();
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		return sampler->getOptions();
+	}
+
+	virtual bool supportsInitialState() const {
+		return sampler->supportsInitialState();
+	}
+
+	virtual const std::string name() const {
+		return sampler->name();
+	}
+
+	virtual const std::string description() const {
+		return sampler->description() + " Reads are distributed over MPI ranks.";
+	}
+
+	virtual ~DWDistributedSampler() {}
+
+protected:
+
+	std::shared_ptr<DWSampler> sampler;
+};
+
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <map>
+#include "DWGaugeSampler.hpp"
+#include "Parallel.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+std::vector<std::int8_t> DWGaugeSampler::getGauge(const IsingProblem& problem,
+		const std::uint64_t seed, const int k) {
+	SplitMix64 rng(seed, k);
+	std::vector<std::int8_t> gauge(problem.size());
+	for (auto& g : gauge) {
+		g = (rng.next() & 1) ? 1 : -1;
+	}
+	return gauge;
+}
+
+SampleSet DWGaugeSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	const int n = std::min(nGauges, params.numReads);
+	if (n <= 1) {
+		return sampler->sample(problem, params);
+	}
+
+	auto seed = getSeed(params);
+	std::map<int, int> index;
+	for (int i = 0; i < problem.size(); i++) {
+		index[problem.getLabels()[i]] = i;
+	}
+
+	std::vector<SampleSet> results(n);
+	parallelFor(n, 1, [&](std::size_t begin, std::size_t end) {
+		for (auto k = begin; k < end; k++) {
+			auto gauge = getGauge(problem, seed, k);
+			auto gaugeParams = params;
+			gaugeParams.numReads = params.numReads / n
+					+ (static_cast<int>(k) < params.numReads % n ? 1 : 0);
+			if (params.seed != 0) {
+				gaugeParams.seed = SplitMix64(seed ^ 0x5DEECE66DULL, k).next() | 1;
+			}
+			if (!params.initialState.empty()) {
+				for (std::size_t i = 0; i < gauge.size(); i++) {
+					gaugeParams.initialState[i] *= gauge[i];
+				}
+			}
+			auto samples = sampler->sample(problem.gauge(gauge), gaugeParams);
+
+			// The mask of the columns whose gauge is -1
+			auto nWords = samples.getWordsPerSample();
+			std::vector<std::uint64_t> mask(nWords, 0);
+			auto& labels = samples.getLabels();
+			for (std::size_t c = 0; c < labels.size(); c++) {
+				auto i = index.find(labels[c]);
+				if (i != index.end() && gauge[i->second] < 0) {
+					mask[c / 64] |= std::uint64_t(1) << (c % 64);
+				}
+			}
+			for (int s = 0; s < samples.size(); s++) {
+				auto row = samples.getRow(s);
+				for (std::size_t w = 0; w < nWords; w++) {
+					row[w] ^= mask[w];
+				}
+			}
+			results[k] = samples;
+		}
+	}, maxConcurrentJobs);
+
+	auto samples = results[0];
+	for (int k = 1; k < n; k++) {
+		samples.append(results[k]);
+	}
+	return samples;
+}
+
+}
+}
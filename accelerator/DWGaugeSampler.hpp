@@ -0,0 +1,106 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWGAUGESAMPLER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWGAUGESAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWGaugeSampler averages out the systematic biases of a sampler
+ * with spin-reversal transforms. It draws a number of random gauges
+ * g, submits the transformed problems h_i g_i, J_ij g_i g_j to the
+ * wrapped sampler concurrently with the reads split evenly among
+ * them, and maps the samples s' of each back to g s'. In the packed
+ * samples that is an XOR of every row with the mask of the qubits
+ * whose gauge is -1, word by word. Energies are left as they are,
+ * as they are invariant under the transform. Samples are appended
+ * in gauge order, so a seeded run is reproducible.
+ */
+class DWGaugeSampler : public DWSampler {
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param wrapped The sampler to run the gauges with
+	 * @param gauges The number of spin-reversal transforms
+	 * @param concurrentJobs The largest number of gauges in flight
+	 */
+	DWGaugeSampler(std::shared_ptr<DWSampler> wrapped, const int gauges,
+			const int concurrentJobs = 8) :
+			sampler(wrapped), nGauges(gauges), maxConcurrentJobs(concurrentJobs) {
+	}
+
+	/**
+	 * Return the k-th random gauge of the
+	 * given problem for the given seed.
+	 */
+	static std::vector<std::int8_t> getGauge(const IsingProblem& problem,
+			const std::uint64_t seed, const int k);
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		return sampler->getOptions();
+	}
+
+	virtual bool supportsInitialState() const {
+		return sampler->supportsInitialState();
+	}
+
+	virtual const std::string name() const {
+		return sampler->name();
+	}
+
+	virtual const std::string description() const {
+		return sampler->description();
+	}
+
+	virtual ~DWGaugeSampler() {}
+
+protected:
+
+	std::shared_ptr<DWSampler> sampler;
+
+	int nGauges;
+
+	int maxConcurrentJobs;
+};
+
+}
+}
+
+#endif
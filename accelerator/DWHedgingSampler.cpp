@@ -0,0 +1,179 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include "DWHedgingSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+constexpr double DWHedgingSampler::defaultDeadline;
+
+double DWHedgingSampler::getDeadline(const int solver) const {
+	auto deadline = statistics->getStartQuantile(solvers[solver].name,
+			deadlineQuantile);
+	if (deadline < 0.0) {
+		deadline = statistics->getStartQuantile("", deadlineQuantile);
+	}
+	return deadline < 0.0 ? defaultDeadline : deadline;
+}
+
+SampleSet DWHedgingSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	std::vector<int> ranking;
+	{
+		std::lock_guard<std::mutex> lock(routing);
+		ranking = rank(problem);
+		statistics->recordSubmission(solvers[ranking[0]].name);
+	}
+
+	// The state the primary job and its hedge share
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool started[2] = {false, false}, done[2] = {false, false};
+	int winner = -1;
+	DWJobControl controls[2];
+
+	// Run job 0 or 1 on the given solver, the first
+	// one to return samples being the winner
+	auto launch = [&](const int job, const int k) {
+		auto submitted = std::chrono::steady_clock::now();
+		auto& name = solvers[k].name;
+		controls[job].onStart = [&, job, submitted, name]() {
+			std::chrono::duration<double> wait = std::chrono::steady_clock::now() - submitted;
+			statistics->recordStart(name, wait.count());
+			std::lock_guard<std::mutex> lock(mutex);
+			started[job] = true;
+			cv.notify_all();
+		};
+		return std::async(std::launch::async, [&, job, k, submitted, name]() {
+			SampleSet samples;
+			try {
+				samples = remoteSamplers[k]->sample(problem, params, &controls[job]);
+			} catch (...) {
+				statistics->recordFailure(name);
+				std::lock_guard<std::mutex> lock(mutex);
+				done[job] = true;
+				cv.notify_all();
+				throw;
+			}
+
+			// A job no longer waited for returns no variables
+			bool answered = samples.getNumberOfVariables() > 0 || !controls[job].cancelled;
+			std::chrono::duration<double> latency = std::chrono::steady_clock::now() - submitted;
+			std::lock_guard<std::mutex> lock(mutex);
+			if (answered) {
+				statistics->recordCompletion(name, latency.count());
+			} else {
+				// A job abandoned in the queue waited at least this
+				// long, which the deadline must learn, or it would
+				// only ever see the waits short enough to start
+				if (!started[job]) {
+					statistics->recordStart(name, latency.count());
+				}
+				statistics->recordCancellation(name);
+			}
+			done[job] = true;
+			if (answered && winner < 0) {
+				winner = job;
+			}
+			cv.notify_all();
+			return samples;
+		});
+	};
+
+	std::future<SampleSet> jobs[2];
+	jobs[0] = launch(0, ranking[0]);
+
+	// Hedge if the job is still queued at the deadline
+	bool hedged = false;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait_for(lock, std::chrono::duration<double>(getDeadline(ranking[0])),
+				[&]() { return started[0] || done[0]; });
+		hedged = !started[0] && !done[0] && ranking.size() > 1;
+	}
+	if (hedged) {
+		xacc::info("D-Wave job still queued on " + solvers[ranking[0]].name
+				+ ", hedging on " + solvers[ranking[1]].name + ".");
+		statistics->recordSubmission(solvers[ranking[1]].name);
+		jobs[1] = launch(1, ranking[1]);
+	}
+
+	// Wait for the first answer, or for every job to end without one
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait(lock, [&]() {
+			return winner >= 0 || (done[0] && (!hedged || done[1]));
+		});
+	}
+	if (hedged && winner >= 0) {
+		controls[1 - winner].cancelled = true;
+	}
+
+	// Collect both jobs, so none outlives the shared state,
+	// rethrowing only if neither answered
+	SampleSet samples;
+	for (int job = 0; job < (hedged ? 2 : 1); job++) {
+		try {
+			auto result = jobs[job].get();
+			if (job == winner) {
+				samples = result;
+			}
+		} catch (...) {
+			if (winner < 0 && job == 0) {
+				if (hedged) {
+					try { jobs[1].get(); } catch (...) {}
+				}
+				throw;
+			}
+		}
+	}
+	if (winner < 0) {
+		xacc::error("No D-Wave job answered.");
+	}
+
+	if (ranking.size() > 1) {
+		statistics->recordHedge(hedged, winner == 1, hedged ? params.numReads : 0);
+		if (hedged) {
+			xacc::info("Hedge " + std::string(winner == 1 ? "won" : "lost")
+					+ ", hedge rate " + std::to_string(statistics->getHedgeRate())
+					+ ", hedge wins " + std::to_string(statistics->getNumberOfHedgeWins())
+					+ ", hedged reads " + std::to_string(statistics->getHedgeReads()));
+		}
+	}
+	return samples;
+}
+
+}
+}
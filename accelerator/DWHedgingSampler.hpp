@@ -0,0 +1,101 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWHEDGINGSAMPLER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWHEDGINGSAMPLER_HPP_
+
+#include "DWRoutingSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWHedgingSampler cuts the tail latency of remote jobs. Each job
+ * goes to the solver the DWRoutingSampler would choose, and if it has
+ * not left that solver's queue by a deadline, the q quantile of the
+ * solver's recent queue waits, the same job is submitted to the next
+ * best fitting solver. The first job to answer wins and the other is
+ * no longer waited for, counted as a cancellation. A job abandoned
+ * while still queued records the time it waited as a lower bound on
+ * its queue wait, so long waits keep raising the deadline. Every request with a second solver to hedge
+ * on is counted in the DWSolverStatistics, with whether it was hedged,
+ * whether the hedge won, and the reads the hedge submitted.
+ */
+class DWHedgingSampler : public DWRoutingSampler {
+
+public:
+
+	/**
+	 * The deadline in seconds used before any queue
+	 * wait has been measured.
+	 */
+	static constexpr double defaultDeadline = 2.0;
+
+	/**
+	 * The constructor, takes the candidate solvers with the remote
+	 * sampler submitting to each, the statistics table and the
+	 * quantile of the queue waits to hedge at.
+	 *
+	 * @param solvers The candidate solvers
+	 * @param samplers The remote sampler of each solver
+	 * @param statistics The table latencies and hedges are recorded in
+	 * @param quantile The quantile of the queue waits to hedge at
+	 */
+	DWHedgingSampler(const std::vector<DWSolver>& solvers,
+			const std::vector<std::shared_ptr<DWRemoteSampler>>& samplers,
+			std::shared_ptr<DWSolverStatistics> statistics,
+			const double quantile = 0.95) :
+			DWRoutingSampler(solvers, std::vector<std::shared_ptr<DWSampler>>(
+					samplers.begin(), samplers.end()), statistics),
+			remoteSamplers(samplers), deadlineQuantile(quantile) {
+	}
+
+	/**
+	 * Return the time in seconds a job may wait in the
+	 * given solver's queue before it is hedged.
+	 */
+	double getDeadline(const int solver) const;
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual ~DWHedgingSampler() {}
+
+protected:
+
+	std::vector<std::shared_ptr<DWRemoteSampler>> remoteSamplers;
+
+	double deadlineQuantile;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,211 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <boost/algorithm/string.hpp>
+#include "DWRemoteSampler.hpp"
+
+#define RAPIDJSON_HAS_STDSTRING 1
+
+#include "rapidjson/document.h"
+
+using namespace rapidjson;
+
+namespace xacc {
+namespace quantum {
+
+SampleSet DWRemoteSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params, DWJobControl* control) {
+	auto json = getProblemJson(problem, params);
+
+	// The submission is not retried, a lost response may still
+	// have queued the job, and posting again would run it twice
+	std::string response;
+	try {
+		response = restClient->post(url, "/sapi/problems", json, headers);
+	} catch (std::exception& e) {
+		xacc::error("D-Wave SAPI problem submission failed, not resubmitting: "
+				+ std::string(e.what()));
+	}
+	return getSamples(response, problem.getOffset(), control);
+}
+
+const std::string DWRemoteSampler::getProblemJson(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	// One line per bias and coupler, in physical qubit indices
+	auto& labels = problem.getLabels();
+	auto& biases = problem.getBiases();
+	std::string data = "";
+	int nLines = 0;
+	for (int i = 0; i < problem.size(); i++) {
+		data += std::to_string(labels[i]) + " " + std::to_string(labels[i])
+				+ " " + std::to_string(biases[i]) + "\\n";
+		nLines++;
+	}
+	for (auto& c : problem.getCouplings()) {
+		data += std::to_string(labels[c.i]) + " " + std::to_string(labels[c.j])
+				+ " " + std::to_string(c.value) + "\\n";
+		nLines++;
+	}
+
+	std::stringstream ss;
+	ss << "[";
+	for (auto e : params.schedule) {
+		ss << "[" << e.first << "," << e.second << "],";
+	}
+	auto annealingStr = ss.str().substr(0, ss.str().length() - 1) + "]";
+
+	// A reverse anneal starts from the given spin of every active
+	// qubit, SAPI expects 3 for the inactive ones
+	std::string initialStateStr = "";
+	if (!params.initialState.empty()) {
+		if (params.initialState.size() != labels.size()) {
+			xacc::error("The initial state does not match the problem size.");
+		}
+		std::vector<int> state(solver.nQubits, 3);
+		for (int i = 0; i < problem.size(); i++) {
+			state[labels[i]] = params.initialState[i];
+		}
+		initialStateStr = ", \"initial_state\" : [";
+		for (int q = 0; q < solver.nQubits; q++) {
+			initialStateStr += (q > 0 ? "," : "") + std::to_string(state[q]);
+		}
+		initialStateStr += "], \"reinitialize_state\" : true";
+	}
+
+	return "[{ \"solver\" : \"" + solver.name + "\", \"type\" : \"ising\", "
+			"\"data\" : \"" + std::to_string(solver.nQubits) + " "
+			+ std::to_string(nLines) + "\\n" + data + "\", \"params\": { "
+			"\"num_reads\" : " + std::to_string(params.numReads)
+			+ ", \"anneal_schedule\" : " + annealingStr + initialStateStr
+			+ ", \"auto_scale\" : true } }]";
+}
+
+SampleSet DWRemoteSampler::getSamples(const std::string& response,
+		const double offset, DWJobControl* control) {
+
+	Document doc;
+	doc.Parse(response);
+
+	// Get the JobID
+	std::string jobId = std::string(doc[0]["id"].GetString());
+
+	// Loop until the job is complete,
+	// get the JSON response
+	std::string msg;
+	bool jobCompleted = false, jobStarted = false;
+	while (!jobCompleted) {
+
+		if (control && control->cancelled) {
+			xacc::info("No longer waiting for D-Wave job " + jobId + ".");
+			return SampleSet();
+		}
+
+		// Execute HTTP Get
+		msg = withRetries([&]() {
+			return restClient->get(url, "/sapi/problems/" + jobId, headers);
+		});
+
+		if (!jobStarted && control && (boost::contains(msg, "IN_PROGRESS")
+				|| boost::contains(msg, "COMPLETED"))) {
+			jobStarted = true;
+			if (control->onStart) {
+				control->onStart();
+			}
+		}
+
+		// Search the result for the status : COMPLETED indicator
+		if (boost::contains(msg, "COMPLETED")) {
+			jobCompleted = true;
+			break;
+		}
+
+		if (boost::contains(msg, "FAILED")) {
+			Document d;
+			d.Parse(msg);
+			xacc::error("D-Wave Execution Failure: " + std::string(d["error_message"].GetString()));
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		xacc::info(msg);
+	}
+
+	doc.Parse(msg);
+	if (std::string(doc["status"].GetString()) != "COMPLETED") {
+		xacc::error("Error in executing D-Wave QPU.");
+	}
+
+	std::vector<int> activeVars;
+	auto activeVarsArray = doc["answer"]["active_variables"].GetArray();
+	for (int i = 0; i < activeVarsArray.Size(); i++) {
+		activeVars.push_back(activeVarsArray[i].GetInt());
+	}
+
+	// Solutions are packed one byte aligned row per
+	// sample, most significant bit first
+	auto decoded = base64_decode(
+			std::string(doc["answer"]["solutions"].GetString()));
+	auto nVars = activeVars.size();
+	auto bytesPerSample = (nVars + 8 - 1) / 8;
+	auto energyArray = doc["answer"]["energies"].GetArray();
+	auto numOccArray = doc["answer"]["num_occurrences"].GetArray();
+
+	SampleSet samples(activeVars);
+	samples.reserve(energyArray.Size());
+	std::vector<std::int8_t> spins(nVars);
+	for (int s = 0; s < energyArray.Size(); s++) {
+		for (std::size_t k = 0; k < nVars; k++) {
+			auto byte = static_cast<unsigned char>(decoded[s * bytesPerSample + k / 8]);
+			spins[k] = ((byte >> (7 - k % 8)) & 1) ? 1 : -1;
+		}
+		samples.append(spins.data(), energyArray[s].GetDouble() + offset,
+				numOccArray[s].GetInt());
+	}
+
+	return samples;
+}
+
+std::string DWRemoteSampler::withRetries(std::function<std::string()> request) {
+	const int nRetries = 5;
+	for (int attempt = 0;; attempt++) {
+		try {
+			return request();
+		} catch (std::exception& e) {
+			if (attempt + 1 == nRetries) {
+				xacc::error("D-Wave SAPI request failed: " + std::string(e.what()));
+			}
+			xacc::info("D-Wave SAPI request failed, retrying: " + std::string(e.what()));
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+	}
+}
+
+}
+}
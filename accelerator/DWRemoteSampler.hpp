@@ -0,0 +1,188 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWREMOTESAMPLER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWREMOTESAMPLER_HPP_
+
+#include <atomic>
+#include <functional>
+#include "RemoteAccelerator.hpp"
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * Wrapper for information related to the remote
+ * D-Wave solver.
+ */
+struct DWSolver {
+	std::string name;
+	std::string description;
+	double jRangeMin;
+	double jRangeMax;
+	double hRangeMin;
+	double hRangeMax;
+	int nQubits;
+	std::vector<std::pair<int,int>> edges;
+	int maxReads = 10000;
+	double maxRunDuration = 1000000.0;
+	double readoutThermalization = 0.0;
+	double averageLoad = 0.0;
+};
+
+/**
+ * Lets the caller of a remote job learn when the job leaves the
+ * solver's queue, and stop waiting for it.
+ */
+struct DWJobControl {
+
+	/**
+	 * Called once, when the job is first seen running or completed.
+	 */
+	std::function<void()> onStart;
+
+	/**
+	 * Set to stop polling the job, which then returns no samples.
+	 */
+	std::atomic<bool> cancelled {false};
+};
+
+/**
+ * The DWRemoteSampler is the DWSampler that posts problems to a
+ * remote D-Wave solver through SAPI and waits for the answer. It is
+ * the DWAccelerator's default sampler, configured by the accelerator
+ * with its HTTP client, SAPI URL and authentication headers.
+ *
+ * Problems are always submitted as Ising problems over the problem's
+ * labels, which are physical qubit indices. QUBOs are converted by
+ * the accelerator beforehand, and the problem's energy offset is
+ * added back to the returned energies.
+ */
+class DWRemoteSampler : public DWSampler {
+
+public:
+
+	/**
+	 * The constructor, takes the client to post problems with, the
+	 * SAPI URL and the HTTP headers to send.
+	 */
+	DWRemoteSampler(std::shared_ptr<Client> client, const std::string& sapiUrl,
+			const std::map<std::string, std::string>& httpHeaders) :
+			restClient(client), url(sapiUrl), headers(httpHeaders) {
+	}
+
+	/**
+	 * Set the solver problems are submitted to.
+	 */
+	void setSolver(const DWSolver& dwSolver) {
+		solver = dwSolver;
+	}
+
+	/**
+	 * Submit the problem, wait for the job to complete
+	 * and return its samples.
+	 */
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params) {
+		return sample(problem, params, nullptr);
+	}
+
+	/**
+	 * Submit the problem and wait for the job to complete, reporting
+	 * its start to and checking for cancellation by the given control.
+	 * A cancelled job returns an empty SampleSet.
+	 */
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params, DWJobControl* control);
+
+	/**
+	 * Return the SAPI problem submission JSON for the
+	 * given problem and parameters.
+	 *
+	 * @param problem The Ising problem over physical qubits
+	 * @param params The number of reads and anneal schedule
+	 * @return json The JSON to post to /sapi/problems
+	 */
+	const std::string getProblemJson(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	/**
+	 * Wait for the job described by the given submission
+	 * response to complete and return its samples.
+	 *
+	 * @param response The response to the problem submission
+	 * @param offset The energy offset to add to the returned energies
+	 * @param control The control of the job, if any
+	 * @return samples The samples over the job's active variables
+	 */
+	SampleSet getSamples(const std::string& response, const double offset = 0.0,
+			DWJobControl* control = nullptr);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		return std::make_shared<options_description>(
+				"D-Wave Remote Sampler Options");
+	}
+
+	virtual bool supportsInitialState() const {
+		return true;
+	}
+
+	virtual const std::string name() const {
+		return "remote";
+	}
+
+	virtual const std::string description() const {
+		return "The Remote Sampler runs problems on a D-Wave QPU through SAPI.";
+	}
+
+	virtual ~DWRemoteSampler() {}
+
+protected:
+
+	std::shared_ptr<Client> restClient;
+
+	std::string url;
+
+	std::map<std::string, std::string> headers;
+
+	DWSolver solver;
+
+	/**
+	 * Issue an idempotent HTTP request, retrying a few
+	 * times if the client throws before giving up.
+	 */
+	std::string withRetries(std::function<std::string()> request);
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,140 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include "DWRoutingSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+DWRoutingSampler::DWRoutingSampler(const std::vector<DWSolver>& candidates,
+		const std::vector<std::shared_ptr<DWSampler>>& candidateSamplers,
+		std::shared_ptr<DWSolverStatistics> table) :
+		solvers(candidates), samplers(candidateSamplers), statistics(table) {
+	if (solvers.empty() || solvers.size() != samplers.size()) {
+		xacc::error("DWRoutingSampler needs one sampler per candidate solver.");
+	}
+	for (auto& solver : solvers) {
+		std::vector<char> qubits(solver.nQubits, 0);
+		std::set<std::pair<int, int>> edges;
+		for (auto& e : solver.edges) {
+			if (e.first < solver.nQubits && e.second < solver.nQubits) {
+				qubits[e.first] = qubits[e.second] = 1;
+			}
+			edges.insert(std::make_pair(std::min(e.first, e.second),
+					std::max(e.first, e.second)));
+		}
+		workingQubits.push_back(qubits);
+		couplers.push_back(edges);
+	}
+}
+
+bool DWRoutingSampler::fits(const int solver, const IsingProblem& problem) const {
+	auto& labels = problem.getLabels();
+	for (auto q : labels) {
+		if (q < 0 || q >= solvers[solver].nQubits || !workingQubits[solver][q]) {
+			return false;
+		}
+	}
+	for (auto& c : problem.getCouplings()) {
+		auto i = labels[c.i], j = labels[c.j];
+		if (!couplers[solver].count(std::make_pair(std::min(i, j), std::max(i, j)))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+double DWRoutingSampler::getEstimatedWait(const int solver) const {
+	auto& name = solvers[solver].name;
+	auto latency = statistics->getLatencyQuantile(name, 0.5);
+	if (latency < 0.0) {
+		latency = statistics->getLatencyQuantile("", 0.5);
+	}
+	if (latency < 0.0) {
+		latency = 1.0;
+	}
+	auto load = std::min(std::max(solvers[solver].averageLoad, 0.0), 0.95);
+	return latency * (1 + statistics->getNumberOfInFlight(name)) / (1.0 - load);
+}
+
+std::vector<int> DWRoutingSampler::rank(const IsingProblem& problem) const {
+	std::vector<std::pair<double, int>> waits;
+	for (int k = 0; k < static_cast<int>(solvers.size()); k++) {
+		if (fits(k, problem)) {
+			waits.push_back(std::make_pair(getEstimatedWait(k), k));
+		}
+	}
+	if (waits.empty()) {
+		xacc::error("No candidate solver fits the problem.");
+	}
+	std::stable_sort(waits.begin(), waits.end(),
+			[](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+				return a.first < b.first;
+			});
+	std::vector<int> ranking;
+	for (auto& w : waits) {
+		ranking.push_back(w.second);
+	}
+	return ranking;
+}
+
+int DWRoutingSampler::route(const IsingProblem& problem) const {
+	return rank(problem)[0];
+}
+
+SampleSet DWRoutingSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	int k;
+	{
+		std::lock_guard<std::mutex> lock(routing);
+		k = route(problem);
+		statistics->recordSubmission(solvers[k].name);
+	}
+	xacc::info("Routing job to " + solvers[k].name + ", estimated wait "
+			+ std::to_string(getEstimatedWait(k)) + " s.");
+
+	auto start = std::chrono::steady_clock::now();
+	SampleSet samples;
+	try {
+		samples = samplers[k]->sample(problem, params);
+	} catch (...) {
+		statistics->recordFailure(solvers[k].name);
+		throw;
+	}
+	std::chrono::duration<double> latency = std::chrono::steady_clock::now() - start;
+	statistics->recordCompletion(solvers[k].name, latency.count());
+	return samples;
+}
+
+}
+}
@@ -0,0 +1,144 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWROUTINGSAMPLER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWROUTINGSAMPLER_HPP_
+
+#include <set>
+#include "DWRemoteSampler.hpp"
+#include "DWSolverStatistics.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWRoutingSampler chooses the solver each submission runs on.
+ * Only solvers whose working graph holds every qubit and coupler of
+ * the physical problem are considered, and among them the one with
+ * the shortest estimated wait is taken,
+ *
+ *    wait = latency * (1 + jobs in flight) / (1 - load),
+ *
+ * where latency is the median latency of the solver's recent jobs
+ * in the DWSolverStatistics table, the median over all solvers for
+ * one without history, and load is the average load SAPI reports for
+ * the solver, capped at 0.95. The DWAccelerator builds a router per
+ * execution, from a solver list it fetches again once older than
+ * --dwave-solvers-refresh seconds, so loads stay current. Jobs in flight count this process'
+ * own queue on the solver, so concurrent submissions spread out.
+ */
+class DWRoutingSampler : public DWSampler {
+
+public:
+
+	/**
+	 * The constructor, takes the candidate solvers with the
+	 * sampler submitting to each, and the statistics table.
+	 *
+	 * @param solvers The candidate solvers
+	 * @param samplers The sampler of each solver
+	 * @param statistics The table latencies are recorded in
+	 */
+	DWRoutingSampler(const std::vector<DWSolver>& solvers,
+			const std::vector<std::shared_ptr<DWSampler>>& samplers,
+			std::shared_ptr<DWSolverStatistics> statistics);
+
+	/**
+	 * Return true if the solver has every qubit and coupler of
+	 * the problem, whose labels are physical qubit indices.
+	 */
+	bool fits(const int solver, const IsingProblem& problem) const;
+
+	/**
+	 * Return the estimated wait in seconds for a job on the solver.
+	 */
+	double getEstimatedWait(const int solver) const;
+
+	/**
+	 * Return the fitting solvers, shortest estimated wait first.
+	 */
+	std::vector<int> rank(const IsingProblem& problem) const;
+
+	/**
+	 * Return the fitting solver with the shortest estimated wait.
+	 */
+	int route(const IsingProblem& problem) const;
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		return samplers[0]->getOptions();
+	}
+
+	virtual bool supportsInitialState() const {
+		for (auto& s : samplers) {
+			if (!s->supportsInitialState()) return false;
+		}
+		return true;
+	}
+
+	virtual const std::string name() const {
+		return samplers[0]->name();
+	}
+
+	virtual const std::string description() const {
+		return samplers[0]->description();
+	}
+
+	virtual ~DWRoutingSampler() {}
+
+protected:
+
+	std::vector<DWSolver> solvers;
+
+	std::vector<std::shared_ptr<DWSampler>> samplers;
+
+	std::shared_ptr<DWSolverStatistics> statistics;
+
+	/**
+	 * The qubits with a coupler, and the couplers
+	 * with i < j, of each solver.
+	 */
+	std::vector<std::vector<char>> workingQubits;
+
+	std::vector<std::set<std::pair<int, int>>> couplers;
+
+	/**
+	 * Held while a solver is chosen and its submission
+	 * recorded, so concurrent jobs see each other.
+	 */
+	std::mutex routing;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,272 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWSOLVERSTATISTICS_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWSOLVERSTATISTICS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWSolverStatistics is a small in-process table of what each
+ * solver has done for this process: the jobs it has in flight, the
+ * jobs it completed, the latency of its last few jobs, from
+ * submission to samples in seconds, and how long they waited in the
+ * queue before starting. Only a bounded history is kept per solver,
+ * so estimates follow the solver's current load. It also counts the
+ * hedged submissions of the DWHedgingSampler. All methods may be
+ * called concurrently.
+ */
+class DWSolverStatistics {
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param historyLength The number of latencies kept per solver
+	 */
+	DWSolverStatistics(const std::size_t historyLength = 64) :
+			maxHistory(historyLength) {
+	}
+
+	/**
+	 * Record a job submitted to the given solver.
+	 */
+	void recordSubmission(const std::string& solver) {
+		std::lock_guard<std::mutex> lock(mutex);
+		table[solver].inFlight++;
+	}
+
+	/**
+	 * Record a job of the given solver that completed
+	 * after the given latency in seconds.
+	 */
+	void recordCompletion(const std::string& solver, const double latency) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& entry = table[solver];
+		entry.inFlight = std::max(0, entry.inFlight - 1);
+		entry.completions++;
+		entry.latencies.push_back(latency);
+		if (entry.latencies.size() > maxHistory) {
+			entry.latencies.pop_front();
+		}
+	}
+
+	/**
+	 * Record a job of the given solver that left the queue after
+	 * waiting the given time in seconds, or a lower bound on its
+	 * wait for a job abandoned while still queued.
+	 */
+	void recordStart(const std::string& solver, const double wait) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& entry = table[solver];
+		entry.waits.push_back(wait);
+		if (entry.waits.size() > maxHistory) {
+			entry.waits.pop_front();
+		}
+	}
+
+	/**
+	 * Record a request that could have been hedged, whether it was,
+	 * whether the hedge answered first, and the reads the hedge
+	 * submitted on top of the original job.
+	 */
+	void recordHedge(const bool hedged, const bool hedgeWon, const int extraReads) {
+		std::lock_guard<std::mutex> lock(mutex);
+		hedgeable++;
+		if (hedged) {
+			hedges++;
+			hedgeWins += hedgeWon ? 1 : 0;
+			hedgeReads += extraReads;
+		}
+	}
+
+	/**
+	 * Record a job of the given solver that ended without samples.
+	 */
+	void recordFailure(const std::string& solver) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& entry = table[solver];
+		entry.inFlight = std::max(0, entry.inFlight - 1);
+		entry.failures++;
+	}
+
+	/**
+	 * Record a job of the given solver that was no longer
+	 * waited for, because another solver answered first.
+	 */
+	void recordCancellation(const std::string& solver) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto& entry = table[solver];
+		entry.inFlight = std::max(0, entry.inFlight - 1);
+		entry.cancellations++;
+	}
+
+	int getNumberOfInFlight(const std::string& solver) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = table.find(solver);
+		return it == table.end() ? 0 : it->second.inFlight;
+	}
+
+	int getNumberOfCompletions(const std::string& solver) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = table.find(solver);
+		return it == table.end() ? 0 : it->second.completions;
+	}
+
+	int getNumberOfFailures(const std::string& solver) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = table.find(solver);
+		return it == table.end() ? 0 : it->second.failures;
+	}
+
+	int getNumberOfCancellations(const std::string& solver) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = table.find(solver);
+		return it == table.end() ? 0 : it->second.cancellations;
+	}
+
+	/**
+	 * Return the q quantile of the recent latencies of the given
+	 * solver, or of all solvers pooled if the name is empty, by the
+	 * nearest rank. Returns -1 when there is no history yet.
+	 *
+	 * @param solver The solver, or empty for all solvers
+	 * @param q The quantile, in [0, 1]
+	 * @return latency The latency quantile in seconds
+	 */
+	double getLatencyQuantile(const std::string& solver, const double q) const {
+		return getQuantile(solver, q, &Entry::latencies);
+	}
+
+	/**
+	 * Return the q quantile of the recent queue waits of the given
+	 * solver, or of all solvers pooled if the name is empty, by the
+	 * nearest rank. Returns -1 when there is no history yet.
+	 */
+	double getStartQuantile(const std::string& solver, const double q) const {
+		return getQuantile(solver, q, &Entry::waits);
+	}
+
+	int getNumberOfHedgeableRequests() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hedgeable;
+	}
+
+	int getNumberOfHedges() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hedges;
+	}
+
+	/**
+	 * Return the number of hedges that answered first.
+	 */
+	int getNumberOfHedgeWins() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hedgeWins;
+	}
+
+	/**
+	 * Return the fraction of hedgeable requests that were hedged.
+	 */
+	double getHedgeRate() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hedgeable > 0 ? double(hedges) / hedgeable : 0.0;
+	}
+
+	/**
+	 * Return the reads submitted by hedges, the extra cost of hedging.
+	 */
+	long getHedgeReads() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return hedgeReads;
+	}
+
+protected:
+
+	struct Entry {
+		int inFlight = 0;
+		int completions = 0;
+		int failures = 0;
+		int cancellations = 0;
+		std::deque<double> latencies;
+		std::deque<double> waits;
+	};
+
+	double getQuantile(const std::string& solver, const double q,
+			std::deque<double> Entry::* history) const {
+		std::vector<double> values;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (auto& kv : table) {
+				if (solver.empty() || kv.first == solver) {
+					auto& h = kv.second.*history;
+					values.insert(values.end(), h.begin(), h.end());
+				}
+			}
+		}
+		if (values.empty()) {
+			return -1.0;
+		}
+		auto rank = static_cast<std::size_t>(std::ceil(
+				std::min(std::max(q, 0.0), 1.0) * values.size()));
+		auto k = rank > 0 ? rank - 1 : 0;
+		std::nth_element(values.begin(), values.begin() + k, values.end());
+		return values[k];
+	}
+
+	int hedgeable = 0;
+
+	int hedges = 0;
+
+	int hedgeWins = 0;
+
+	long hedgeReads = 0;
+
+	std::size_t maxHistory;
+
+	std::map<std::string, Entry> table;
+
+	mutable std::mutex mutex;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include "DWSplitSampler.hpp"
+#include "Parallel.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+constexpr double DWSplitSampler::readoutTime;
+
+int DWSplitSampler::getReadsPerJob(const DWSamplerParameters& params) const {
+	auto annealTime = params.schedule.empty() ? 0.0 : params.schedule.back().first;
+	auto byDuration = std::floor(maxRunDuration / (annealTime + overhead));
+	return std::max(1, static_cast<int>(std::min<double>(maxReads, byDuration)));
+}
+
+SampleSet DWSplitSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	auto readsPerJob = getReadsPerJob(params);
+	if (params.numReads <= readsPerJob) {
+		return sampler->sample(problem, params);
+	}
+
+	const int nJobs = (params.numReads + readsPerJob - 1) / readsPerJob;
+	xacc::info("Splitting " + std::to_string(params.numReads) + " reads into "
+			+ std::to_string(nJobs) + " jobs.");
+
+	// One worker per job in flight, each job with its own
+	// stream of the seed, results kept in job order
+	std::vector<SampleSet> results(nJobs);
+	parallelFor(nJobs, 1, [&](std::size_t begin, std::size_t end) {
+		for (auto j = begin; j < end; j++) {
+			auto jobParams = params;
+			jobParams.numReads = params.numReads / nJobs
+					+ (static_cast<int>(j) < params.numReads % nJobs ? 1 : 0);
+			if (params.seed != 0) {
+				jobParams.seed = SplitMix64(params.seed, j).next() | 1;
+			}
+			results[j] = sampler->sample(problem, jobParams);
+		}
+	}, maxConcurrentJobs);
+
+	auto samples = results[0];
+	for (int j = 1; j < nJobs; j++) {
+		samples.append(results[j]);
+	}
+	return samples;
+}
+
+}
+}
@@ -0,0 +1,118 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef QUANTUM_AQC_ACCELERATORS_DWSPLITSAMPLER_HPP_
+#define QUANTUM_AQC_ACCELERATORS_DWSPLITSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The DWSplitSampler splits requests for more reads than a solver
+ * accepts in one job, by its read limit or its run time limit, into
+ * the fewest jobs under both limits, with the reads spread evenly.
+ * The jobs are submitted concurrently to the wrapped sampler, a few
+ * at a time, and their samples are appended in job order. Duplicates
+ * across jobs are merged when the DWAccelerator aggregates the
+ * samples it stores. Requests under the limits go straight through.
+ */
+class DWSplitSampler : public DWSampler {
+
+public:
+
+	/**
+	 * A typical time in microseconds to read out one sample,
+	 * counted towards the run time limit besides the anneal.
+	 */
+	static constexpr double readoutTime = 150.0;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param remoteSampler The sampler to split requests for
+	 * @param readLimit The largest number of reads in one job
+	 * @param runDurationLimit The longest run time of one job in microseconds
+	 * @param readOverhead The time each read takes besides the anneal
+	 * @param concurrentJobs The largest number of jobs in flight
+	 */
+	DWSplitSampler(std::shared_ptr<DWSampler> remoteSampler, const int readLimit,
+			const double runDurationLimit, const double readOverhead,
+			const int concurrentJobs = 8) :
+			sampler(remoteSampler), maxReads(readLimit),
+			maxRunDuration(runDurationLimit), overhead(readOverhead),
+			maxConcurrentJobs(concurrentJobs) {
+	}
+
+	/**
+	 * Return the largest number of reads of the
+	 * given request that fit in one job.
+	 */
+	int getReadsPerJob(const DWSamplerParameters& params) const;
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		return sampler->getOptions();
+	}
+
+	virtual bool supportsInitialState() const {
+		return sampler->supportsInitialState();
+	}
+
+	virtual const std::string name() const {
+		return sampler->name();
+	}
+
+	virtual const std::string description() const {
+		return sampler->description();
+	}
+
+	virtual ~DWSplitSampler() {}
+
+protected:
+
+	std::shared_ptr<DWSampler> sampler;
+
+	int maxReads;
+
+	double maxRunDuration;
+
+	double overhead;
+
+	int maxConcurrentJobs;
+};
+
+}
+}
+
+#endif
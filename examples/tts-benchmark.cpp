@@ -0,0 +1,256 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include "XACC.hpp"
+#include "DWAccelerator.hpp"
+#include "TimeToSolution.hpp"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+
+/**
+ * Sweep the anneal time and the number of reads over a set of
+ * problem instances, and print the ground state probability and
+ * TTS99 of every run, with bootstrapped 95% confidence intervals,
+ * as JSON. Instances are files of "i j value" lines, the body of a
+ * dwave-qmi kernel, with # comments. The reference energy is the
+ * exact ground state energy, from the exact sampler, or the best
+ * energy seen for the instance over the whole sweep.
+ *
+ * tts-benchmark --tts-instances a.qmi,b.qmi --tts-anneal-times 5,20,100
+ *     --tts-num-reads 100,1000 [--tts-reference exact|best]
+ *     [--tts-bootstrap 1000] [--tts-output results.json]
+ *     [XACC options, e.g. --dwave-sampler sqa]
+ */
+
+struct Instance {
+	std::string name;
+	std::string kernelName;
+	std::string body;
+	std::shared_ptr<xacc::quantum::DWKernel> kernel;
+};
+
+struct Run {
+	int instance;
+	double annealTime;
+	int numReads;
+	xacc::quantum::SampleSet samples;
+};
+
+std::vector<std::string> split(const std::string& list) {
+	std::vector<std::string> items;
+	boost::split(items, list, boost::is_any_of(","));
+	return items;
+}
+
+Instance readInstance(const std::string& fileName) {
+	std::ifstream file(fileName);
+	if (!file) {
+		xacc::error("Could not open instance " + fileName);
+	}
+	Instance instance;
+	instance.name = boost::filesystem::path(fileName).stem().string();
+
+	// The file stem, as a valid kernel identifier
+	instance.kernelName = instance.name;
+	for (auto& c : instance.kernelName) {
+		if (!std::isalnum(static_cast<unsigned char>(c))) {
+			c = '_';
+		}
+	}
+	if (instance.kernelName.empty() || std::isdigit(
+			static_cast<unsigned char>(instance.kernelName[0]))) {
+		instance.kernelName = "tts_" + instance.kernelName;
+	}
+	instance.kernel = std::make_shared<xacc::quantum::DWKernel>(instance.kernelName);
+	std::string line;
+	while (std::getline(file, line)) {
+		boost::trim(line);
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		int i, j;
+		double value;
+		std::istringstream ss(line);
+		if (!(ss >> i >> j >> value)) {
+			xacc::error("Invalid line in " + fileName + ": " + line);
+		}
+		instance.body += "   " + line + "\n";
+		instance.kernel->addInstruction(
+				std::make_shared<xacc::quantum::DWQMI>(i, j, value));
+	}
+	return instance;
+}
+
+void writeNumber(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer,
+		const double value) {
+	if (std::isfinite(value)) {
+		writer.Double(value);
+	} else {
+		writer.Null();
+	}
+}
+
+int main(int argc, char** argv) {
+
+	// Take the benchmark arguments out, and give the rest to XACC
+	std::map<std::string, std::string> args {{"--tts-reference", "exact"},
+			{"--tts-bootstrap", "1000"}};
+	std::vector<char*> xaccArgv {argv[0]};
+	for (int i = 1; i < argc; i++) {
+		std::string arg(argv[i]);
+		if (boost::starts_with(arg, "--tts-") && i + 1 < argc) {
+			args[arg] = argv[++i];
+		} else {
+			xaccArgv.push_back(argv[i]);
+		}
+	}
+	int xaccArgc = xaccArgv.size();
+	xacc::Initialize(xaccArgc, xaccArgv.data());
+
+	if (!args.count("--tts-instances") || !args.count("--tts-anneal-times")
+			|| !args.count("--tts-num-reads")) {
+		xacc::error("tts-benchmark needs --tts-instances, --tts-anneal-times "
+				"and --tts-num-reads.");
+	}
+	auto nBootstrap = std::stoi(args["--tts-bootstrap"]);
+	auto reference = args["--tts-reference"];
+	if (reference != "exact" && reference != "best") {
+		xacc::error("--tts-reference must be exact or best.");
+	}
+
+	xacc::setOption("compiler", "dwave-qmi");
+	auto qpu = xacc::getAccelerator("dwave");
+
+	std::vector<Instance> instances;
+	std::vector<double> referenceEnergies;
+	for (auto& fileName : split(args["--tts-instances"])) {
+		instances.push_back(readInstance(fileName));
+		auto energy = std::numeric_limits<double>::infinity();
+		if (reference == "exact") {
+			auto problem = xacc::quantum::DWAccelerator::toIsingProblem(
+					instances.back().kernel);
+			xacc::quantum::DWSamplerParameters params;
+			params.numReads = 1;
+			auto ground = xacc::getService<xacc::quantum::DWSampler>("exact")->sample(
+					problem, params);
+			energy = ground.getEnergies()[0];
+		}
+		referenceEnergies.push_back(energy);
+	}
+
+	// Run the sweep, keeping the logical samples of every run
+	std::vector<Run> runs;
+	for (std::size_t k = 0; k < instances.size(); k++) {
+		auto src = "__qpu__ " + instances[k].kernelName + "() {\n" + instances[k].body + "}";
+		auto buffer = qpu->createBuffer("tts_" + std::to_string(k));
+		xacc::Program program(qpu, src);
+		program.build();
+		auto kernel = program.getKernel(instances[k].kernelName);
+
+		for (auto& annealTime : split(args["--tts-anneal-times"])) {
+			for (auto& numReads : split(args["--tts-num-reads"])) {
+				xacc::setOption("dwave-anneal-time", annealTime);
+				xacc::setOption("dwave-num-reads", numReads);
+				kernel(buffer);
+
+				auto dwBuffer = std::dynamic_pointer_cast<
+						xacc::quantum::DWAcceleratorBuffer>(buffer);
+				Run run {static_cast<int>(k), std::stod(annealTime),
+						std::stoi(numReads), dwBuffer->getLogicalSamples()};
+				if (reference == "best") {
+					for (auto e : run.samples.getEnergies()) {
+						referenceEnergies[k] = std::min(referenceEnergies[k], e);
+					}
+				}
+				runs.push_back(run);
+			}
+		}
+	}
+
+	rapidjson::StringBuffer out;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(out);
+	writer.StartObject();
+	writer.String("sampler");
+	writer.String(xacc::optionExists("dwave-sampler") ?
+			xacc::getOption("dwave-sampler") : "remote");
+	writer.String("reference");
+	writer.String(reference);
+	writer.String("runs");
+	writer.StartArray();
+	for (std::size_t r = 0; r < runs.size(); r++) {
+		auto& run = runs[r];
+		auto estimate = xacc::quantum::estimateTTS(run.samples,
+				referenceEnergies[run.instance], run.annealTime, nBootstrap,
+				0.95, r);
+		writer.StartObject();
+		writer.String("instance");
+		writer.String(instances[run.instance].name);
+		writer.String("referenceEnergy");
+		writeNumber(writer, referenceEnergies[run.instance]);
+		writer.String("annealTime");
+		writer.Double(run.annealTime);
+		writer.String("numReads");
+		writer.Int(run.numReads);
+		writer.String("successProbability");
+		writeNumber(writer, estimate.successProbability);
+		writer.String("successProbabilityCI");
+		writer.StartArray();
+		writeNumber(writer, estimate.successLower);
+		writeNumber(writer, estimate.successUpper);
+		writer.EndArray();
+		writer.String("tts99");
+		writeNumber(writer, estimate.tts);
+		writer.String("tts99CI");
+		writer.StartArray();
+		writeNumber(writer, estimate.ttsLower);
+		writeNumber(writer, estimate.ttsUpper);
+		writer.EndArray();
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	if (args.count("--tts-output")) {
+		std::ofstream file(args["--tts-output"]);
+		file << out.GetString() << "\n";
+	} else {
+		std::cout << out.GetString() << "\n";
+	}
+
+	xacc::Finalize();
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include "ExactSampler.hpp"
+#include "PopulationAnnealingSampler.hpp"
+#include "SimulatedBifurcationSampler.hpp"
+#include "SimulatedQuantumAnnealingSampler.hpp"
+#include "StateVectorSampler.hpp"
+#include "TabuSampler.hpp"
+#include "VariableEliminationSampler.hpp"
+
+#include "cppmicroservices/BundleActivator.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/ServiceProperties.h"
+
+#include <memory>
+#include <set>
+
+using namespace cppmicroservices;
+
+namespace {
+
+/**
+ */
+class US_ABI_LOCAL DWSamplersActivator: public BundleActivator {
+
+public:
+
+	DWSamplersActivator() {
+	}
+
+	/**
+	 */
+	void Start(BundleContext context) {
+		auto pa = std::make_shared<xacc::quantum::PopulationAnnealingSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(pa);
+		context.RegisterService<xacc::OptionsProvider>(pa);
+
+		auto sqa = std::make_shared<xacc::quantum::SimulatedQuantumAnnealingSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(sqa);
+		context.RegisterService<xacc::OptionsProvider>(sqa);
+
+		auto tabu = std::make_shared<xacc::quantum::TabuSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(tabu);
+		context.RegisterService<xacc::OptionsProvider>(tabu);
+
+		auto exact = std::make_shared<xacc::quantum::ExactSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(exact);
+		context.RegisterService<xacc::OptionsProvider>(exact);
+
+		auto ve = std::make_shared<xacc::quantum::VariableEliminationSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(ve);
+		context.RegisterService<xacc::OptionsProvider>(ve);
+
+		auto sv = std::make_shared<xacc::quantum::StateVectorSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(sv);
+		context.RegisterService<xacc::OptionsProvider>(sv);
+
+		auto sb = std::make_shared<xacc::quantum::SimulatedBifurcationSampler>();
+		context.RegisterService<xacc::quantum::DWSampler>(sb);
+		context.RegisterService<xacc::OptionsProvider>(sb);
+	}
+
+	/**
+	 */
+	void Stop(BundleContext /*context*/) {
+	}
+
+};
+
+}
+
+CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(DWSamplersActivator)
@@ -0,0 +1,323 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <random>
+#include "ExactSampler.hpp"
+#include "Parallel.hpp"
+
+namespace xacc {
+namespace quantum {
+
+namespace {
+
+// The largest problem we are willing to enumerate
+const int maxExactVariables = 40;
+
+/**
+ * Return the dense row-major coupling matrix of the problem if it
+ * is dense enough for contiguous row updates to beat the CSR
+ * neighbor updates, or an empty vector otherwise.
+ */
+std::vector<double> denseCouplings(const IsingProblem& problem) {
+	std::size_t n = problem.size();
+	if (4 * problem.getNeighbors().size() < n * n) {
+		return std::vector<double>();
+	}
+	std::vector<double> dense(n * n, 0.0);
+	for (auto& c : problem.getCouplings()) {
+		dense[c.i * n + c.j] = c.value;
+		dense[c.j * n + c.i] = c.value;
+	}
+	return dense;
+}
+
+/**
+ * Visit every state whose highest bits are the given task index, in
+ * Gray code order over the nLow lowest bits, calling visit(x, E)
+ * with the state x (bit i set for spin +1) and its energy E.
+ */
+template<typename Visitor>
+void enumerate(const IsingProblem& problem, const std::vector<double>& dense,
+		const std::uint64_t task, const int nLow, Visitor visit) {
+	const int n = problem.size();
+	auto& rowOffsets = problem.getRowOffsets();
+	auto& neighbors = problem.getNeighbors();
+	auto& couplingValues = problem.getCouplingValues();
+
+	std::uint64_t x = task << nLow;
+	std::vector<std::int8_t> s(n);
+	for (int i = 0; i < n; i++) {
+		s[i] = ((x >> i) & 1) ? 1 : -1;
+	}
+	std::vector<double> f(n);
+	for (int i = 0; i < n; i++) {
+		f[i] = problem.localField(i, s.data());
+	}
+	double energy = problem.energy(s.data());
+	visit(x, energy);
+
+	auto fields = f.data();
+	const std::uint64_t count = std::uint64_t(1) << nLow;
+	for (std::uint64_t t = 1; t < count; t++) {
+		int k = __builtin_ctzll(t);
+		double old = s[k];
+		energy -= 2.0 * old * fields[k];
+		s[k] = -s[k];
+		x ^= std::uint64_t(1) << k;
+
+		auto c = -2.0 * old;
+		if (!dense.empty()) {
+			auto row = &dense[k * n];
+			for (int j = 0; j < n; j++) {
+				fields[j] += c * row[j];
+			}
+		} else {
+			for (int j = rowOffsets[k]; j < rowOffsets[k + 1]; j++) {
+				fields[neighbors[j]] += c * couplingValues[j];
+			}
+		}
+
+		visit(x, energy);
+	}
+}
+
+/**
+ * Return the number of high bits to split the state
+ * space on, giving every thread several tasks.
+ */
+int numberOfTaskBits(const int n) {
+	int bits = 0;
+	while (bits < n && (1 << bits) < 16 * getNumberOfThreads()) {
+		bits++;
+	}
+	return bits;
+}
+
+void unpack(const std::uint64_t x, const int n, std::vector<std::int8_t>& s) {
+	for (int i = 0; i < n; i++) {
+		s[i] = ((x >> i) & 1) ? 1 : -1;
+	}
+}
+
+/**
+ * Compute the partition function of every task, as
+ * sums[t] in units of exp(-beta shifts[t]), where
+ * shifts[t] is the lowest energy of task t.
+ */
+void taskPartitionFunctions(const IsingProblem& problem,
+		const std::vector<double>& dense, const int nLow, const double beta,
+		std::vector<double>& shifts, std::vector<double>& sums) {
+	parallelFor(shifts.size(), 1, [&](std::size_t begin, std::size_t end) {
+		for (auto task = begin; task < end; task++) {
+			double shift = std::numeric_limits<double>::infinity(), sum = 0.0;
+			enumerate(problem, dense, task, nLow, [&](std::uint64_t x, double e) {
+				if (e < shift) {
+					sum = (sum > 0.0 ? sum * std::exp(-beta * (shift - e)) : 0.0) + 1.0;
+					shift = e;
+				} else {
+					sum += std::exp(-beta * (e - shift));
+				}
+			});
+			shifts[task] = shift;
+			sums[task] = sum;
+		}
+	});
+}
+
+}
+
+SampleSet ExactSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	const int n = problem.size();
+	if (n > maxExactVariables) {
+		xacc::error("The exact sampler supports at most "
+				+ std::to_string(maxExactVariables) + " variables, this problem has "
+				+ std::to_string(n) + ".");
+	}
+
+	std::string mode = "ground";
+	double beta = 1.0;
+	if (xacc::optionExists("dwave-exact-mode")) {
+		mode = xacc::getOption("dwave-exact-mode");
+	}
+	if (xacc::optionExists("dwave-exact-beta")) {
+		beta = std::stod(xacc::getOption("dwave-exact-beta"));
+	}
+	if (mode != "ground" && mode != "boltzmann") {
+		xacc::error("Invalid dwave-exact-mode " + mode + ", must be ground or boltzmann.");
+	}
+
+	auto dense = denseCouplings(problem);
+	auto nHigh = numberOfTaskBits(n), nLow = n - nHigh;
+	std::size_t nTasks = std::size_t(1) << nHigh;
+	std::vector<std::uint64_t> states;
+
+	if (mode == "ground") {
+
+		// Keep the numReads lowest states of every task in a max heap
+		std::size_t k = params.numReads;
+		using Entry = std::pair<double, std::uint64_t>;
+		std::vector<std::vector<Entry>> lowest(nTasks);
+		parallelFor(nTasks, 1, [&](std::size_t begin, std::size_t end) {
+			for (auto task = begin; task < end; task++) {
+				std::priority_queue<Entry> heap;
+				enumerate(problem, dense, task, nLow, [&](std::uint64_t x, double e) {
+					if (heap.size() < k) {
+						heap.push(std::make_pair(e, x));
+					} else if (e < heap.top().first) {
+						heap.pop();
+						heap.push(std::make_pair(e, x));
+					}
+				});
+				for (; !heap.empty(); heap.pop()) {
+					lowest[task].push_back(heap.top());
+				}
+			}
+		});
+
+		std::vector<Entry> all;
+		for (auto& l : lowest) {
+			all.insert(all.end(), l.begin(), l.end());
+		}
+		k = std::min(k, all.size());
+		std::partial_sort(all.begin(), all.begin() + k, all.end());
+		for (std::size_t m = 0; m < k; m++) {
+			states.push_back(all[m].second);
+		}
+
+	} else {
+
+		// First pass, the partition function of every task, in
+		// units of exp(-beta E_min) of that task
+		std::vector<double> shifts(nTasks), sums(nTasks);
+		taskPartitionFunctions(problem, dense, nLow, beta, shifts, sums);
+
+		auto globalShift = *std::min_element(shifts.begin(), shifts.end());
+		std::vector<double> weights(nTasks);
+		double total = 0.0;
+		for (std::size_t t = 0; t < nTasks; t++) {
+			weights[t] = sums[t] * std::exp(-beta * (shifts[t] - globalShift));
+			total += weights[t];
+		}
+		xacc::info("Exact sampler log partition function at beta = "
+				+ std::to_string(beta) + ": "
+				+ std::to_string(-beta * globalShift + std::log(total)));
+
+		// Draw the targets on the cumulative weights, and hand
+		// each task the ones that fall inside it, in its own units
+		std::mt19937_64 rng(getSeed(params));
+		std::uniform_real_distribution<double> uniform(0.0, total);
+		std::vector<double> targets(params.numReads);
+		for (auto& u : targets) u = uniform(rng);
+		std::sort(targets.begin(), targets.end());
+
+		std::vector<std::vector<double>> taskTargets(nTasks);
+		std::size_t task = 0;
+		double cumulative = 0.0;
+		for (auto u : targets) {
+			while (task + 1 < nTasks && u >= cumulative + weights[task]) {
+				cumulative += weights[task++];
+			}
+			taskTargets[task].push_back((u - cumulative)
+					/ std::exp(-beta * (shifts[task] - globalShift)));
+		}
+
+		// Second pass, walk the cumulative weights of every task with
+		// targets and emit the states they land on
+		std::vector<std::vector<std::uint64_t>> drawn(nTasks);
+		parallelFor(nTasks, 1, [&](std::size_t begin, std::size_t end) {
+			for (auto t = begin; t < end; t++) {
+				auto& ts = taskTargets[t];
+				if (ts.empty()) continue;
+				std::size_t next = 0;
+				double c = 0.0;
+				std::uint64_t last = 0;
+				enumerate(problem, dense, t, nLow, [&](std::uint64_t x, double e) {
+					c += std::exp(-beta * (e - shifts[t]));
+					while (next < ts.size() && ts[next] < c) {
+						drawn[t].push_back(x);
+						next++;
+					}
+					last = x;
+				});
+				// Rounding may leave the last targets just past the end
+				for (; next < ts.size(); next++) {
+					drawn[t].push_back(last);
+				}
+			}
+		});
+
+		for (auto& d : drawn) {
+			states.insert(states.end(), d.begin(), d.end());
+		}
+		std::shuffle(states.begin(), states.end(), rng);
+	}
+
+	SampleSet samples(problem.getLabels());
+	samples.reserve(states.size());
+	std::vector<std::int8_t> spins(n);
+	for (auto x : states) {
+		unpack(x, n, spins);
+		samples.append(spins.data(), problem.energy(spins.data()));
+	}
+
+	return samples;
+}
+
+double ExactSampler::logPartitionFunction(const IsingProblem& problem,
+		const double beta) {
+
+	const int n = problem.size();
+	if (n > maxExactVariables) {
+		xacc::error("The exact sampler supports at most "
+				+ std::to_string(maxExactVariables) + " variables.");
+	}
+
+	auto dense = denseCouplings(problem);
+	auto nHigh = numberOfTaskBits(n), nLow = n - nHigh;
+	std::size_t nTasks = std::size_t(1) << nHigh;
+	std::vector<double> shifts(nTasks), sums(nTasks);
+	taskPartitionFunctions(problem, dense, nLow, beta, shifts, sums);
+
+	auto globalShift = *std::min_element(shifts.begin(), shifts.end());
+	double total = 0.0;
+	for (std::size_t t = 0; t < nTasks; t++) {
+		total += sums[t] * std::exp(-beta * (shifts[t] - globalShift));
+	}
+	return -beta * globalShift + std::log(total);
+}
+
+}
+}
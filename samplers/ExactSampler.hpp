@@ -0,0 +1,98 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_EXACTSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_EXACTSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The ExactSampler enumerates all 2^N states of problems with up
+ * to 40 variables. The state space is split on its highest bits
+ * into independent tasks run in parallel, and each task walks its
+ * states in Gray code order, so consecutive states differ by one
+ * flip and the energy and local fields are updated incrementally.
+ * Local fields are updated over the CSR neighbors of the flipped
+ * variable for sparse problems, and with a contiguous dense coupling
+ * row, which the compiler vectorizes, for dense ones.
+ *
+ * By default the numReads lowest energy states are returned, ground
+ * states first. With --dwave-exact-mode boltzmann, numReads exact
+ * samples of the Boltzmann distribution at --dwave-exact-beta are
+ * returned instead, drawn with a second enumeration pass.
+ */
+class ExactSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	/**
+	 * Return the natural log of the partition function
+	 * Z = sum_s exp(-beta E(s)) of the given problem.
+	 *
+	 * @param problem The Ising problem
+	 * @param beta The inverse temperature
+	 * @return logZ The log of the partition function
+	 */
+	double logPartitionFunction(const IsingProblem& problem, const double beta);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"Exact Sampler Options");
+		desc->add_options()("dwave-exact-mode", value<std::string>(),
+				"ground (default) to return the lowest energy states, or "
+				"boltzmann to return exact Boltzmann samples.")
+				("dwave-exact-beta", value<std::string>(),
+				"The inverse temperature of the Boltzmann samples, default 1.");
+		return desc;
+	}
+
+	virtual const std::string name() const {
+		return "exact";
+	}
+
+	virtual const std::string description() const {
+		return "The Exact Sampler enumerates all states of small problems "
+				"to return exact ground states or Boltzmann samples.";
+	}
+
+	virtual ~ExactSampler() {}
+
+};
+
+}
+}
+
+#endif
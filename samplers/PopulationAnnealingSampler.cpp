@@ -0,0 +1,208 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <boost/algorithm/string.hpp>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "PopulationAnnealingSampler.hpp"
+#include "Parallel.hpp"
+
+namespace xacc {
+namespace quantum {
+
+namespace {
+
+// Number of replicas handled by one parallel chunk
+const std::size_t replicaGrain = 64;
+
+/**
+ * Seed a generator for one chunk of replicas at one temperature
+ * step, so results only depend on the seed and not on scheduling.
+ */
+std::mt19937_64 chunkGenerator(const std::uint64_t seed, const int step,
+		const std::size_t begin) {
+	std::seed_seq seq { std::uint32_t(seed), std::uint32_t(seed >> 32),
+			std::uint32_t(step), std::uint32_t(begin) };
+	return std::mt19937_64(seq);
+}
+
+}
+
+SampleSet PopulationAnnealingSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	int populationSize = 1000, nTemperatures = 100, nSweeps = 10;
+	if (xacc::optionExists("dwave-pa-population-size")) {
+		populationSize = std::stoi(xacc::getOption("dwave-pa-population-size"));
+	}
+	if (xacc::optionExists("dwave-pa-num-temperatures")) {
+		nTemperatures = std::stoi(xacc::getOption("dwave-pa-num-temperatures"));
+	}
+	if (xacc::optionExists("dwave-pa-num-sweeps")) {
+		nSweeps = std::stoi(xacc::getOption("dwave-pa-num-sweeps"));
+	}
+	populationSize = std::max(populationSize, params.numReads);
+	if (populationSize < 1 || nTemperatures < 1 || nSweeps < 0) {
+		xacc::error("Invalid population annealing parameters.");
+	}
+
+	// Default to the hottest temperature at which any flip is
+	// accepted with probability 1/2, and the coldest at which
+	// the smallest uphill flip is accepted with probability 1/100.
+	auto maxDelta = problem.maxFlipEnergy(), minDelta = problem.minFlipEnergy();
+	double betaHot = std::log(2.0) / (maxDelta > 0.0 ? maxDelta : 1.0);
+	double betaCold = std::log(100.0) / (minDelta > 0.0 ? minDelta : 1.0);
+	if (xacc::optionExists("dwave-pa-beta-range")) {
+		std::vector<std::string> split;
+		boost::split(split, xacc::getOption("dwave-pa-beta-range"),
+				boost::is_any_of(","));
+		if (split.size() != 2) {
+			xacc::error("dwave-pa-beta-range must be given as 'hot,cold'.");
+		}
+		betaHot = std::stod(split[0]);
+		betaCold = std::stod(split[1]);
+	}
+
+	// The population starts uniformly random, a perfect sample at
+	// beta = 0, and then follows a geometric inverse temperature ladder.
+	std::vector<double> betas(1, 0.0);
+	for (int k = 0; k < nTemperatures; k++) {
+		auto frac = nTemperatures > 1 ? double(k) / (nTemperatures - 1) : 1.0;
+		betas.push_back(betaHot * std::pow(betaCold / betaHot, frac));
+	}
+
+	auto seed = getSeed(params);
+	const std::size_t n = problem.size(), R = populationSize;
+	auto& rowOffsets = problem.getRowOffsets();
+	auto& neighbors = problem.getNeighbors();
+	auto& couplingValues = problem.getCouplingValues();
+	auto& biases = problem.getBiases();
+
+	// The replica arenas, swapped at every resampling step
+	std::vector<std::int8_t> spins(R * n), nextSpins(R * n);
+	std::vector<double> energies(R), nextEnergies(R);
+	std::vector<double> weights(R);
+	std::vector<std::size_t> copies(R);
+
+	parallelFor(R, replicaGrain, [&](std::size_t begin, std::size_t end) {
+		auto rng = chunkGenerator(seed, 0, begin);
+		for (auto r = begin; r < end; r++) {
+			auto s = &spins[r * n];
+			for (std::size_t i = 0; i < n; i++) {
+				s[i] = (rng() & 1) ? 1 : -1;
+			}
+			energies[r] = problem.energy(s);
+		}
+	});
+
+	std::mt19937_64 resampleRng(seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	for (std::size_t k = 1; k < betas.size(); k++) {
+		auto beta = betas[k];
+
+		// Resample by the relative Boltzmann weights, shifted by
+		// the lowest energy so the weights never overflow
+		auto dBeta = beta - betas[k - 1];
+		auto eMin = *std::min_element(energies.begin(), energies.end());
+		parallelFor(R, replicaGrain, [&](std::size_t begin, std::size_t end) {
+			for (auto r = begin; r < end; r++) {
+				weights[r] = std::exp(-dBeta * (energies[r] - eMin));
+			}
+		});
+		auto totalWeight = parallelExclusiveScan(weights);
+
+		// Systematic resampling, replica r gets the number of points
+		// u, u+1, ... that fall in its slice of the cumulative weights
+		auto u = uniform(resampleRng);
+		auto scale = double(R) / totalWeight;
+		parallelFor(R, replicaGrain, [&](std::size_t begin, std::size_t end) {
+			for (auto r = begin; r < end; r++) {
+				auto lo = static_cast<std::size_t>(std::floor(weights[r] * scale + u));
+				auto hi = r + 1 == R ? R : static_cast<std::size_t>(
+						std::floor(weights[r + 1] * scale + u));
+				copies[r] = std::min(R, hi) - std::min(R, lo);
+			}
+		});
+		parallelExclusiveScan(copies);
+
+		parallelFor(R, replicaGrain, [&](std::size_t begin, std::size_t end) {
+			for (auto r = begin; r < end; r++) {
+				auto last = r + 1 == R ? R : copies[r + 1];
+				for (auto dst = copies[r]; dst < last; dst++) {
+					std::memcpy(&nextSpins[dst * n], &spins[r * n], n);
+					nextEnergies[dst] = energies[r];
+				}
+			}
+		});
+		spins.swap(nextSpins);
+		energies.swap(nextEnergies);
+
+		// Equilibrate every replica at the new temperature
+		parallelFor(R, replicaGrain, [&](std::size_t begin, std::size_t end) {
+			auto rng = chunkGenerator(seed, k, begin);
+			std::uniform_real_distribution<double> accept(0.0, 1.0);
+			for (auto r = begin; r < end; r++) {
+				auto s = &spins[r * n];
+				auto energy = energies[r];
+				for (int sweep = 0; sweep < nSweeps; sweep++) {
+					for (std::size_t i = 0; i < n; i++) {
+						double field = biases[i];
+						for (int j = rowOffsets[i]; j < rowOffsets[i + 1]; j++) {
+							field += couplingValues[j] * s[neighbors[j]];
+						}
+						auto delta = -2.0 * s[i] * field;
+						if (delta <= 0.0 || accept(rng) < std::exp(-beta * delta)) {
+							s[i] = -s[i];
+							energy += delta;
+						}
+					}
+				}
+				energies[r] = energy;
+			}
+		});
+	}
+
+	// Return evenly strided replicas, so that each read comes from
+	// as different a family of the final population as possible
+	SampleSet samples(problem.getLabels());
+	samples.reserve(params.numReads);
+	for (int m = 0; m < params.numReads; m++) {
+		auto r = static_cast<std::size_t>(m) * R / params.numReads;
+		samples.append(&spins[r * n], problem.energy(&spins[r * n]));
+	}
+
+	return samples;
+}
+
+}
+}
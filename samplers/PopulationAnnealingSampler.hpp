@@ -0,0 +1,93 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_POPULATIONANNEALINGSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_POPULATIONANNEALINGSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The PopulationAnnealingSampler anneals a large population of
+ * replicas from infinite temperature down to a cold inverse
+ * temperature. At each temperature step the population is resampled
+ * by the Boltzmann weights exp(-(beta_k+1 - beta_k) E), so the final
+ * population is a well equilibrated thermal sample at the cold
+ * temperature, and then every replica is relaxed with Metropolis
+ * sweeps.
+ *
+ * Replicas live in two flat arenas (spins and energies) that are
+ * swapped at every resampling step, so no memory is allocated once
+ * the anneal has started. Resampling is systematic, with the replica
+ * copy counts and destination offsets computed by parallel prefix sums,
+ * and the Metropolis sweeps are run in parallel over the replicas.
+ */
+class PopulationAnnealingSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"Population Annealing Sampler Options");
+		desc->add_options()("dwave-pa-population-size", value<std::string>(),
+				"The number of replicas in the population, default 1000 "
+				"(at least the number of reads).")
+				("dwave-pa-num-temperatures", value<std::string>(),
+				"The number of temperature steps, default 100.")
+				("dwave-pa-num-sweeps", value<std::string>(),
+				"The number of Metropolis sweeps per temperature step, default 10.")
+				("dwave-pa-beta-range", value<std::string>(),
+				"The hot and cold inverse temperatures as 'hot,cold'. "
+				"Derived from the problem coefficients by default.");
+		return desc;
+	}
+
+	virtual const std::string name() const {
+		return "population-annealing";
+	}
+
+	virtual const std::string description() const {
+		return "The Population Annealing Sampler draws thermal samples by "
+				"annealing and resampling a population of replicas locally.";
+	}
+
+	virtual ~PopulationAnnealingSampler() {}
+
+};
+
+}
+}
+
+#endif
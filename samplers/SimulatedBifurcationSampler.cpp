@@ -0,0 +1,166 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include "SimulatedBifurcationSampler.hpp"
+#include "Parallel.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+SampleSet SimulatedBifurcationSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	bool discrete = true;
+	int nSteps = 1000;
+	double dt = 0.5;
+	if (xacc::optionExists("dwave-sb-mode")) {
+		auto mode = xacc::getOption("dwave-sb-mode");
+		if (mode != "ballistic" && mode != "discrete") {
+			xacc::error("Invalid dwave-sb-mode " + mode
+					+ ", must be ballistic or discrete.");
+		}
+		discrete = mode == "discrete";
+	}
+	if (xacc::optionExists("dwave-sb-num-steps")) {
+		nSteps = std::stoi(xacc::getOption("dwave-sb-num-steps"));
+	}
+	if (xacc::optionExists("dwave-sb-dt")) {
+		dt = std::stod(xacc::getOption("dwave-sb-dt"));
+	}
+	if (nSteps < 1 || dt <= 0.0) {
+		xacc::error("Invalid simulated bifurcation parameters.");
+	}
+
+	const std::size_t n = problem.size(), R = params.numReads, W = 64;
+	auto& rowOffsets = problem.getRowOffsets();
+	auto& neighbors = problem.getNeighbors();
+	auto& couplingValues = problem.getCouplingValues();
+	auto& biases = problem.getBiases();
+
+	// c0 = 1/2 sqrt(n - 1) / ||J||_F keeps the coupling comparable
+	// to the pump, with the biases counted as couplings
+	double norm = 0.0;
+	for (auto v : couplingValues) norm += v * v;
+	for (auto h : biases) norm += 2.0 * h * h;
+	const double a0 = 1.0;
+	const double c0 = norm > 0.0 ?
+			0.5 * std::sqrt(std::max<double>(1.0, n - 1.0)) / std::sqrt(norm) : 0.0;
+
+	// Dense problems use the full coupling matrix so the
+	// product runs without indirection
+	bool dense = 4 * couplingValues.size() >= n * n;
+	std::vector<double> matrix;
+	if (dense) {
+		matrix.assign(n * n, 0.0);
+		for (std::size_t i = 0; i < n; i++) {
+			for (int k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
+				matrix[i * n + neighbors[k]] = couplingValues[k];
+			}
+		}
+	}
+
+	auto seed = getSeed(params);
+	auto nBatches = (R + W - 1) / W;
+	std::vector<std::int8_t> spins(R * n);
+	parallelFor(nBatches, 1, [&](std::size_t begin, std::size_t end) {
+
+		// Row i of each matrix holds variable i of all W trajectories
+		std::vector<double> x(n * W), y(n * W), z(n * W), force(n * W);
+
+		for (auto batch = begin; batch < end; batch++) {
+			SplitMix64 rng(seed, batch);
+			for (std::size_t k = 0; k < n * W; k++) {
+				x[k] = 0.2 * rng.uniform() - 0.1;
+				y[k] = 0.2 * rng.uniform() - 0.1;
+			}
+
+			for (int step = 0; step < nSteps; step++) {
+				auto detuning = a0 - a0 * step / nSteps;
+
+				const double* source = x.data();
+				if (discrete) {
+					for (std::size_t k = 0; k < n * W; k++) {
+						z[k] = x[k] > 0.0 ? 1.0 : (x[k] < 0.0 ? -1.0 : 0.0);
+					}
+					source = z.data();
+				}
+
+				// force = -(h + J z), as one product over the batch
+				for (std::size_t i = 0; i < n; i++) {
+					auto f = &force[i * W];
+					for (std::size_t w = 0; w < W; w++) f[w] = -biases[i];
+					if (dense) {
+						for (std::size_t j = 0; j < n; j++) {
+							auto value = matrix[i * n + j];
+							if (value == 0.0) continue;
+							auto s = source + j * W;
+							for (std::size_t w = 0; w < W; w++) f[w] -= value * s[w];
+						}
+					} else {
+						for (int k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
+							auto value = couplingValues[k];
+							auto s = source + neighbors[k] * W;
+							for (std::size_t w = 0; w < W; w++) f[w] -= value * s[w];
+						}
+					}
+				}
+
+				for (std::size_t k = 0; k < n * W; k++) {
+					y[k] += (-detuning * x[k] + c0 * force[k]) * dt;
+					x[k] += a0 * y[k] * dt;
+					auto wall = std::fabs(x[k]) > 1.0;
+					x[k] = std::max(-1.0, std::min(1.0, x[k]));
+					y[k] = wall ? 0.0 : y[k];
+				}
+			}
+
+			for (std::size_t w = 0; w < W && batch * W + w < R; w++) {
+				auto out = &spins[(batch * W + w) * n];
+				for (std::size_t i = 0; i < n; i++) {
+					out[i] = x[i * W + w] >= 0.0 ? 1 : -1;
+				}
+			}
+		}
+	});
+
+	SampleSet samples(problem.getLabels());
+	samples.reserve(R);
+	for (std::size_t r = 0; r < R; r++) {
+		samples.append(&spins[r * n], problem.energy(&spins[r * n]));
+	}
+
+	return samples;
+}
+
+}
+}
@@ -0,0 +1,93 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_SIMULATEDBIFURCATIONSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_SIMULATEDBIFURCATIONSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The SimulatedBifurcationSampler integrates the ballistic (bSB) or
+ * discrete (dSB) simulated bifurcation equations of Goto et al. Each
+ * read is a trajectory of positions x and momenta y,
+ *
+ *    y_i += (-(a0 - a(t)) x_i - c0 (h_i + sum_j J_ij z_j)) dt
+ *    x_i += a0 y_i dt
+ *
+ * with z = x for bSB and z = sign(x) for dSB, and positions clamped
+ * to [-1, 1] by perfectly inelastic walls. The pump a(t) ramps from
+ * 0 to a0, and each read returns sign(x).
+ *
+ * Trajectories are integrated in independent batches. A batch holds
+ * its positions and momenta as n x W matrices, so the force on all
+ * its trajectories is one product of the coupling matrix with an
+ * n x W matrix, and every update is a vectorizable loop over W. The
+ * couplings are used as CSR rows for sparse problems, and as a dense
+ * matrix for dense ones, like fully connected QUBOs.
+ */
+class SimulatedBifurcationSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"Simulated Bifurcation Sampler Options");
+		desc->add_options()("dwave-sb-mode", value<std::string>(),
+				"The simulated bifurcation variant, ballistic or discrete (default).")
+				("dwave-sb-num-steps", value<std::string>(),
+				"The number of integration steps, default 1000.")
+				("dwave-sb-dt", value<std::string>(),
+				"The integration time step, default 0.5.");
+		return desc;
+	}
+
+	virtual const std::string name() const {
+		return "simulated-bifurcation";
+	}
+
+	virtual const std::string description() const {
+		return "The Simulated Bifurcation Sampler solves dense problems with "
+				"batched ballistic or discrete simulated bifurcation.";
+	}
+
+	virtual ~SimulatedBifurcationSampler() {}
+
+};
+
+}
+}
+
+#endif
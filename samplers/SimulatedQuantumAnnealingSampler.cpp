@@ -0,0 +1,169 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <limits>
+#include "SimulatedQuantumAnnealingSampler.hpp"
+#include "AnnealingFunctions.hpp"
+#include "Parallel.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+SampleSet SimulatedQuantumAnnealingSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	int nSlices = 32;
+	double beta = 4.0, sweepsPerUs = 100.0;
+	if (xacc::optionExists("dwave-sqa-num-slices")) {
+		nSlices = std::stoi(xacc::getOption("dwave-sqa-num-slices"));
+	}
+	if (xacc::optionExists("dwave-sqa-beta")) {
+		beta = std::stod(xacc::getOption("dwave-sqa-beta"));
+	}
+	if (xacc::optionExists("dwave-sqa-sweeps-per-us")) {
+		sweepsPerUs = std::stod(xacc::getOption("dwave-sqa-sweeps-per-us"));
+	}
+	if (nSlices < 2 || nSlices % 2 != 0) {
+		xacc::error("dwave-sqa-num-slices must be an even number >= 2.");
+	}
+	if (beta <= 0.0 || sweepsPerUs <= 0.0) {
+		xacc::error("Invalid simulated quantum annealing parameters.");
+	}
+
+	auto functions = AnnealingFunctions::fromOptions(params.schedule);
+	auto nSweeps = std::max(1, static_cast<int>(std::round(
+			functions.getTotalTime() * sweepsPerUs)));
+
+	auto seed = getSeed(params);
+	const std::size_t n = problem.size(), P = nSlices, R = params.numReads;
+	auto& rowOffsets = problem.getRowOffsets();
+	auto& neighbors = problem.getNeighbors();
+	auto& couplingValues = problem.getCouplingValues();
+	auto& biases = problem.getBiases();
+
+	// Slice k of read r lives at spins[(r * P + k) * n], with
+	// one generator per slice so slices can update in any order
+	std::vector<std::int8_t> spins(R * P * n);
+	std::vector<SplitMix64> generators;
+	generators.reserve(R * P);
+	for (std::size_t u = 0; u < R * P; u++) {
+		generators.emplace_back(seed, u);
+	}
+
+	// Start from independent random slices when the anneal starts
+	// quantum, or from one classical state replicated across the
+	// slices when it starts classical (a reverse anneal), the given
+	// initial state or a random one.
+	bool classicalStart = functions.getS(0.0) >= 0.5;
+	auto& initialState = params.initialState;
+	if (classicalStart && !initialState.empty() && initialState.size() != n) {
+		xacc::error("The initial state does not match the problem size.");
+	}
+	parallelFor(R, 16, [&](std::size_t begin, std::size_t end) {
+		for (auto r = begin; r < end; r++) {
+			for (std::size_t k = 0; k < P; k++) {
+				auto& rng = generators[r * P + (classicalStart ? 0 : k)];
+				auto slice = &spins[(r * P + k) * n];
+				if (classicalStart && k > 0) {
+					std::copy(&spins[r * P * n], &spins[r * P * n] + n, slice);
+					continue;
+				}
+				if (classicalStart && !initialState.empty()) {
+					std::copy(initialState.begin(), initialState.end(), slice);
+					continue;
+				}
+				for (std::size_t i = 0; i < n; i++) {
+					slice[i] = (rng.next() & 1) ? 1 : -1;
+				}
+			}
+		}
+	});
+
+	auto nUnits = R * P / 2;
+	auto grain = std::max<std::size_t>(1, 16384 / (n + 1));
+	auto minField = 1e-9 * functions.getTransverseField(0.0);
+	for (int sweep = 0; sweep < nSweeps; sweep++) {
+		auto t = (sweep + 0.5) / nSweeps * functions.getTotalTime();
+		auto s = functions.getS(t);
+
+		// Dimensionless weights of the problem and the imaginary time coupling
+		auto classical = beta * functions.getLongitudinalField(s) / (2.0 * P);
+		auto transverse = std::max(functions.getTransverseField(s), minField);
+		auto coupling = -0.5 * std::log(std::tanh(beta * transverse / (2.0 * P)));
+
+		for (std::size_t parity = 0; parity < 2; parity++) {
+			parallelFor(nUnits, grain, [&](std::size_t begin, std::size_t end) {
+				for (auto u = begin; u < end; u++) {
+					auto r = u / (P / 2);
+					auto k = 2 * (u % (P / 2)) + parity;
+					auto& rng = generators[r * P + k];
+					auto slice = &spins[(r * P + k) * n];
+					auto prev = &spins[(r * P + (k + P - 1) % P) * n];
+					auto next = &spins[(r * P + (k + 1) % P) * n];
+					for (std::size_t i = 0; i < n; i++) {
+						double field = biases[i];
+						for (int j = rowOffsets[i]; j < rowOffsets[i + 1]; j++) {
+							field += couplingValues[j] * slice[neighbors[j]];
+						}
+						auto delta = -2.0 * slice[i]
+								* (classical * field - coupling * (prev[i] + next[i]));
+						if (delta <= 0.0 || rng.uniform() < std::exp(-delta)) {
+							slice[i] = -slice[i];
+						}
+					}
+				}
+			});
+		}
+	}
+
+	// Each read returns its lowest energy slice
+	SampleSet samples(problem.getLabels());
+	samples.reserve(R);
+	for (std::size_t r = 0; r < R; r++) {
+		auto best = &spins[r * P * n];
+		auto bestEnergy = problem.energy(best);
+		for (std::size_t k = 1; k < P; k++) {
+			auto slice = &spins[(r * P + k) * n];
+			auto e = problem.energy(slice);
+			if (e < bestEnergy) {
+				best = slice;
+				bestEnergy = e;
+			}
+		}
+		samples.append(best, bestEnergy);
+	}
+
+	return samples;
+}
+
+}
+}
@@ -0,0 +1,99 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_SIMULATEDQUANTUMANNEALINGSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_SIMULATEDQUANTUMANNEALINGSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The SimulatedQuantumAnnealingSampler runs path integral Monte
+ * Carlo along the requested anneal schedule. Each read is a ring of
+ * P Trotter slices of the problem, coupled in imaginary time by
+ *
+ *    K(s) = -1/2 ln tanh(beta A(s) / 2P),
+ *
+ * while each slice feels the problem scaled by beta B(s) / 2P, with
+ * A(s) and B(s) given by the AnnealingFunctions. Physical time is
+ * mapped to Monte Carlo sweeps, so pauses and reverse anneals in the
+ * schedule are honored.
+ *
+ * All slices of all reads are stored in one contiguous array. A
+ * sweep updates the even slices of every read in parallel, then the
+ * odd ones, which is exact since slices only couple to their
+ * imaginary time neighbors. Each read returns its lowest energy slice.
+ */
+class SimulatedQuantumAnnealingSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"Simulated Quantum Annealing Sampler Options");
+		desc->add_options()("dwave-sqa-num-slices", value<std::string>(),
+				"The number of Trotter slices, an even number, default 32.")
+				("dwave-sqa-beta", value<std::string>(),
+				"The inverse temperature in 1/GHz, default 4 (about 12 mK).")
+				("dwave-sqa-sweeps-per-us", value<std::string>(),
+				"The number of Monte Carlo sweeps per microsecond of anneal, default 100.")
+				("dwave-transverse-field-scale", value<std::string>(),
+				"A(0) in GHz for the local anneal simulators, default 6.")
+				("dwave-longitudinal-field-scale", value<std::string>(),
+				"B(1) in GHz for the local anneal simulators, default 11.");
+		return desc;
+	}
+
+	virtual bool supportsInitialState() const {
+		return true;
+	}
+
+	virtual const std::string name() const {
+		return "sqa";
+	}
+
+	virtual const std::string description() const {
+		return "The Simulated Quantum Annealing Sampler runs path integral "
+				"Monte Carlo along the kernel's anneal schedule locally.";
+	}
+
+	virtual ~SimulatedQuantumAnnealingSampler() {}
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,216 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include "StateVectorSampler.hpp"
+#include "AnnealingFunctions.hpp"
+#include "Parallel.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+namespace {
+
+// Amplitudes per cache block, 64 KB of real and imaginary parts
+const int blockBits = 12;
+
+/**
+ * Rotate the amplitude pairs (a[k], b[k]) by exp(i theta X),
+ * given the cosine and sine of theta.
+ */
+inline void rotate(double* ar, double* ai, double* br, double* bi,
+		const std::size_t length, const double c, const double s) {
+	for (std::size_t k = 0; k < length; k++) {
+		auto tr = ar[k], ti = ai[k], ur = br[k], ui = bi[k];
+		ar[k] = c * tr - s * ui;
+		ai[k] = c * ti + s * ur;
+		br[k] = c * ur - s * ti;
+		bi[k] = c * ui + s * tr;
+	}
+}
+
+/**
+ * Multiply the state by exp(-i phase H_ising), if phase is
+ * nonzero, then rotate every qubit by exp(i theta X).
+ */
+void applyStep(std::vector<double>& re, std::vector<double>& im,
+		const std::vector<double>& energies, const int n, const double phase,
+		const double theta) {
+	auto lowBits = std::min(n, blockBits);
+	auto blockSize = std::size_t(1) << lowBits;
+	auto c = std::cos(theta), s = std::sin(theta);
+
+	parallelFor(std::size_t(1) << (n - lowBits), 1,
+			[&](std::size_t begin, std::size_t end) {
+		for (auto block = begin; block < end; block++) {
+			auto r = &re[block << lowBits];
+			auto m = &im[block << lowBits];
+			if (phase != 0.0) {
+				auto e = &energies[block << lowBits];
+				for (std::size_t k = 0; k < blockSize; k++) {
+					auto cr = std::cos(phase * e[k]), ci = -std::sin(phase * e[k]);
+					auto tr = r[k];
+					r[k] = tr * cr - m[k] * ci;
+					m[k] = tr * ci + m[k] * cr;
+				}
+			}
+			for (int q = 0; q < lowBits; q++) {
+				auto stride = std::size_t(1) << q;
+				for (std::size_t base = 0; base < blockSize; base += 2 * stride) {
+					rotate(r + base, m + base, r + base + stride, m + base + stride,
+							stride, c, s);
+				}
+			}
+		}
+	});
+
+	// Qubits above the block pair up whole contiguous blocks
+	for (int q = lowBits; q < n; q++) {
+		auto stride = std::size_t(1) << q;
+		parallelFor(std::size_t(1) << (n - 1 - lowBits), 1,
+				[&](std::size_t begin, std::size_t end) {
+			for (auto pair = begin; pair < end; pair++) {
+				auto y = pair << lowBits;
+				auto x = ((y >> q) << (q + 1)) | (y & (stride - 1));
+				rotate(&re[x], &im[x], &re[x + stride], &im[x + stride], blockSize,
+						c, s);
+			}
+		});
+	}
+}
+
+}
+
+std::vector<double> StateVectorSampler::evolve(const IsingProblem& problem,
+		const AnnealSchedule& schedule) {
+
+	double timeScale = 1.0, stepsPerNs = 50.0;
+	if (xacc::optionExists("dwave-sv-time-scale")) {
+		timeScale = std::stod(xacc::getOption("dwave-sv-time-scale"));
+	}
+	if (xacc::optionExists("dwave-sv-steps-per-ns")) {
+		stepsPerNs = std::stod(xacc::getOption("dwave-sv-steps-per-ns"));
+	}
+	if (timeScale < 0.0 || stepsPerNs <= 0.0) {
+		xacc::error("Invalid state vector sampler parameters.");
+	}
+
+	const int n = problem.size();
+	if (n > 28) {
+		xacc::error("The state vector sampler is limited to 28 qubits, this "
+				"problem has " + std::to_string(n) + ".");
+	}
+
+	auto functions = AnnealingFunctions::fromOptions(schedule);
+	const std::size_t dim = std::size_t(1) << n;
+
+	// The diagonal of H_ising, one coefficient at a time
+	// over each block so the inner loops vectorize
+	auto& biases = problem.getBiases();
+	auto& couplings = problem.getCouplings();
+	std::vector<double> energies(dim);
+	parallelFor(dim, std::size_t(1) << blockBits,
+			[&](std::size_t begin, std::size_t end) {
+		auto e = &energies[0];
+		for (auto x = begin; x < end; x++) e[x] = 0.0;
+		for (int i = 0; i < n; i++) {
+			auto h = biases[i];
+			for (auto x = begin; x < end; x++) {
+				e[x] += h * (2.0 * ((x >> i) & 1) - 1.0);
+			}
+		}
+		for (auto& c : couplings) {
+			for (auto x = begin; x < end; x++) {
+				e[x] += c.value * (1.0 - 2.0 * (((x >> c.i) ^ (x >> c.j)) & 1));
+			}
+		}
+	});
+
+	std::vector<double> re(dim, 0.0), im(dim, 0.0);
+	if (functions.getS(0.0) >= 0.5) {
+		re[std::min_element(energies.begin(), energies.end()) - energies.begin()] = 1.0;
+	} else {
+		std::fill(re.begin(), re.end(), 1.0 / std::sqrt(double(dim)));
+	}
+
+	// Strang splitting, with the trailing half rotation of
+	// each step merged into the leading one of the next
+	const double pi = 3.141592653589793;
+	auto totalNs = functions.getTotalTime() * timeScale;
+	auto nSteps = std::max(1, static_cast<int>(std::round(totalNs * stepsPerNs)));
+	auto dt = totalNs / nSteps;
+	double phase = 0.0, halfAngle = 0.0;
+	for (int k = 0; k < nSteps; k++) {
+		auto s = functions.getS((k + 0.5) / nSteps * functions.getTotalTime());
+		auto nextHalfAngle = 0.5 * pi * functions.getTransverseField(s) * dt;
+		applyStep(re, im, energies, n, phase, halfAngle + nextHalfAngle);
+		phase = pi * functions.getLongitudinalField(s) * dt;
+		halfAngle = nextHalfAngle;
+	}
+	applyStep(re, im, energies, n, phase, halfAngle);
+
+	parallelFor(dim, std::size_t(1) << blockBits,
+			[&](std::size_t begin, std::size_t end) {
+		for (auto x = begin; x < end; x++) {
+			re[x] = re[x] * re[x] + im[x] * im[x];
+		}
+	});
+
+	return re;
+}
+
+SampleSet StateVectorSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	auto probabilities = evolve(problem, params.schedule);
+	auto total = parallelExclusiveScan(probabilities);
+
+	SplitMix64 rng(getSeed(params));
+	const int n = problem.size();
+	std::vector<std::int8_t> spins(n);
+	SampleSet samples(problem.getLabels());
+	samples.reserve(params.numReads);
+	for (int r = 0; r < params.numReads; r++) {
+		auto u = rng.uniform() * total;
+		std::size_t x = std::upper_bound(probabilities.begin(),
+				probabilities.end(), u) - probabilities.begin() - 1;
+		for (int i = 0; i < n; i++) {
+			spins[i] = ((x >> i) & 1) ? 1 : -1;
+		}
+		samples.append(spins.data(), problem.energy(spins.data()));
+	}
+
+	return samples;
+}
+
+}
+}
@@ -0,0 +1,111 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_STATEVECTORSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_STATEVECTORSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The StateVectorSampler integrates the closed system dynamics of
+ * the transverse field Ising Hamiltonian given by the
+ * AnnealingFunctions along the requested anneal schedule, and samples
+ * the final measurement distribution. It is meant for small kernels,
+ * the state takes 2^(n+4) bytes.
+ *
+ * The evolution is split into a second order Trotter product of
+ * diagonal phases exp(-i 2pi B(s)/2 H_ising dt) and transverse field
+ * rotations. All rotations commute, so the half rotations of
+ * consecutive steps are merged. The state is stored as separate real
+ * and imaginary arrays so the inner loops vectorize. The phase and the
+ * rotations of the low qubits are applied together on cache sized
+ * blocks of the state, then each high qubit is rotated in one pass
+ * over contiguous pairs of blocks, all in parallel.
+ *
+ * Coherent evolution over microseconds is adiabatic to numerical
+ * precision, so schedule times are scaled by --dwave-sv-time-scale to
+ * nanoseconds of evolution. Forward anneals start from the transverse
+ * field ground state, and anneals starting at s >= 0.5, like reverse
+ * anneals, start from the lowest energy classical state.
+ */
+class StateVectorSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	/**
+	 * Evolve the given problem along the given schedule and
+	 * return the final probability of each basis state. Bit i of
+	 * the basis state index is set if spin i is +1.
+	 *
+	 * @param problem The Ising problem
+	 * @param schedule The anneal schedule
+	 * @return probabilities The final measurement distribution
+	 */
+	std::vector<double> evolve(const IsingProblem& problem,
+			const AnnealSchedule& schedule);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"State Vector Sampler Options");
+		desc->add_options()("dwave-sv-time-scale", value<std::string>(),
+				"Nanoseconds of coherent evolution per microsecond of "
+				"anneal schedule, default 1.")
+				("dwave-sv-steps-per-ns", value<std::string>(),
+				"The number of Trotter steps per nanosecond of evolution, default 50.")
+				("dwave-transverse-field-scale", value<std::string>(),
+				"A(0) in GHz for the local anneal simulators, default 6.")
+				("dwave-longitudinal-field-scale", value<std::string>(),
+				"B(1) in GHz for the local anneal simulators, default 11.");
+		return desc;
+	}
+
+	virtual const std::string name() const {
+		return "state-vector";
+	}
+
+	virtual const std::string description() const {
+		return "The State Vector Sampler simulates the coherent anneal "
+				"dynamics of small kernels exactly and samples the result.";
+	}
+
+	virtual ~StateVectorSampler() {}
+
+};
+
+}
+}
+
+#endif
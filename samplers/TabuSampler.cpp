@@ -0,0 +1,206 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include "TabuSampler.hpp"
+#include "Parallel.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+SampleSet TabuSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	int nRestarts = params.numReads;
+	if (xacc::optionExists("dwave-tabu-num-restarts")) {
+		nRestarts = std::max(nRestarts,
+				std::stoi(xacc::getOption("dwave-tabu-num-restarts")));
+	}
+
+	auto seed = getSeed(params);
+	const std::size_t n = problem.size();
+	std::vector<std::int8_t> states(nRestarts * n);
+	std::vector<double> energies(nRestarts);
+	for (int r = 0; r < nRestarts; r++) {
+		SplitMix64 rng(seed, r);
+		for (std::size_t i = 0; i < n; i++) {
+			states[r * n + i] = (rng.next() & 1) ? 1 : -1;
+		}
+	}
+
+	search(problem, states, energies);
+
+	// Keep the best restarts
+	std::vector<int> order(nRestarts);
+	for (int r = 0; r < nRestarts; r++) order[r] = r;
+	std::partial_sort(order.begin(), order.begin() + params.numReads, order.end(),
+			[&](int a, int b) {return energies[a] < energies[b];});
+
+	SampleSet samples(problem.getLabels());
+	samples.reserve(params.numReads);
+	for (int m = 0; m < params.numReads; m++) {
+		samples.append(&states[order[m] * n], energies[order[m]]);
+	}
+
+	return samples;
+}
+
+SampleSet TabuSampler::polish(const IsingProblem& problem,
+		const SampleSet& samples) {
+
+	if (samples.getLabels() != problem.getLabels()) {
+		xacc::error("TabuSampler: samples to polish must be over the problem's variables.");
+	}
+
+	const std::size_t n = problem.size();
+	std::vector<std::int8_t> states(samples.size() * n);
+	std::vector<double> energies(samples.size());
+	for (int r = 0; r < samples.size(); r++) {
+		samples.getSpins(r, &states[r * n]);
+	}
+
+	search(problem, states, energies);
+
+	SampleSet polished(problem.getLabels());
+	polished.reserve(samples.size());
+	for (int r = 0; r < samples.size(); r++) {
+		polished.append(&states[r * n], energies[r],
+				samples.getNumberOfOccurrences()[r]);
+	}
+
+	return polished;
+}
+
+void TabuSampler::search(const IsingProblem& problem,
+		std::vector<std::int8_t>& states, std::vector<double>& energies) {
+
+	const std::size_t n = problem.size();
+	long long tenure = std::min<long long>(20, n / 4);
+	long long maxStall = std::max<long long>(1000, 10 * n);
+	long long timeout = -1;
+	if (xacc::optionExists("dwave-tabu-tenure")) {
+		tenure = std::stoll(xacc::getOption("dwave-tabu-tenure"));
+	}
+	if (xacc::optionExists("dwave-tabu-max-stall")) {
+		maxStall = std::stoll(xacc::getOption("dwave-tabu-max-stall"));
+	}
+	if (xacc::optionExists("dwave-tabu-timeout")) {
+		timeout = std::stoll(xacc::getOption("dwave-tabu-timeout"));
+	}
+
+	auto& rowOffsets = problem.getRowOffsets();
+	auto& neighbors = problem.getNeighbors();
+	auto& couplingValues = problem.getCouplingValues();
+	const double eps = 1e-12;
+
+	auto deadline = std::chrono::steady_clock::now()
+			+ std::chrono::milliseconds(std::max<long long>(0, timeout));
+	std::atomic<bool> expired(false);
+
+	parallelFor(energies.size(), 1, [&](std::size_t begin, std::size_t end) {
+		std::vector<double> delta(n);
+		std::vector<long long> tabuUntil(n);
+		std::vector<std::int8_t> best(n);
+
+		for (auto r = begin; r < end; r++) {
+			auto s = &states[r * n];
+			std::copy(s, s + n, best.begin());
+			std::fill(tabuUntil.begin(), tabuUntil.end(), 0);
+			for (std::size_t i = 0; i < n; i++) {
+				delta[i] = -2.0 * s[i] * problem.localField(i, s);
+			}
+
+			auto energy = problem.energy(s), bestEnergy = energy;
+			long long stall = 0;
+			for (long long iter = 0; stall < maxStall && !expired; iter++) {
+				if (timeout >= 0 && (iter & 63) == 0
+						&& std::chrono::steady_clock::now() > deadline) {
+					expired = true;
+					break;
+				}
+
+				// The best allowed move, a tabu move is
+				// allowed if it improves on the best energy
+				int move = -1;
+				auto moveDelta = std::numeric_limits<double>::infinity();
+				for (std::size_t i = 0; i < n; i++) {
+					if (delta[i] < moveDelta && (tabuUntil[i] <= iter
+							|| energy + delta[i] < bestEnergy - eps)) {
+						move = i;
+						moveDelta = delta[i];
+					}
+				}
+				if (move < 0) {
+					stall++;
+					continue;
+				}
+
+				auto old = s[move];
+				s[move] = -old;
+				energy += moveDelta;
+				delta[move] = -moveDelta;
+				for (int k = rowOffsets[move]; k < rowOffsets[move + 1]; k++) {
+					auto j = neighbors[k];
+					delta[j] += 4.0 * couplingValues[k] * s[j] * old;
+				}
+				tabuUntil[move] = iter + tenure + 1;
+
+				if (energy < bestEnergy - eps) {
+					bestEnergy = energy;
+					std::copy(s, s + n, best.begin());
+					stall = 0;
+				} else {
+					stall++;
+				}
+			}
+
+			// Restarts cut short or skipped by the time limit may not
+			// be at a local minimum yet, so finish with a greedy descent
+			std::copy(best.begin(), best.end(), s);
+			for (bool improved = true; improved;) {
+				improved = false;
+				for (std::size_t i = 0; i < n; i++) {
+					if (-2.0 * s[i] * problem.localField(i, s) < -eps) {
+						s[i] = -s[i];
+						improved = true;
+					}
+				}
+			}
+			energies[r] = problem.energy(s);
+		}
+	});
+}
+
+}
+}
@@ -0,0 +1,112 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_TABUSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_TABUSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The TabuSampler runs multi-start tabu search. Each restart keeps
+ * the energy change of every one-flip move in a flat delta array,
+ * updated incrementally over the neighbors of the flipped variable,
+ * and the iteration until which every variable is tabu, so the
+ * tenure check is a single comparison. At every iteration the best
+ * non-tabu move is taken, or a tabu one if it improves on the best
+ * energy found so far.
+ *
+ * Restarts are independent, and are pulled by the worker threads
+ * from a shared counter until they are all done or the wall-clock
+ * time limit is reached. Restarts cut short or never run by then are
+ * descended greedily to a local minimum, so every returned sample is
+ * at least one. Restarts start from random states, or from given
+ * samples when polishing the results of another sampler.
+ */
+class TabuSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	/**
+	 * Run one tabu search restart from each of the given samples,
+	 * returning the best state found by each.
+	 *
+	 * @param problem The Ising problem
+	 * @param samples The samples to polish, over the problem's variables
+	 * @return polished The polished samples, same order and occurrences
+	 */
+	virtual SampleSet polish(const IsingProblem& problem, const SampleSet& samples);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"Tabu Sampler Options");
+		desc->add_options()("dwave-tabu-tenure", value<std::string>(),
+				"The number of iterations a flipped variable stays tabu, "
+				"default min(20, N/4).")
+				("dwave-tabu-num-restarts", value<std::string>(),
+				"The number of independent restarts, default (and at least) the number of reads.")
+				("dwave-tabu-max-stall", value<std::string>(),
+				"Stop a restart after this many iterations without improvement, "
+				"default max(1000, 10 N).")
+				("dwave-tabu-timeout", value<std::string>(),
+				"The wall-clock time limit in milliseconds, default none.");
+		return desc;
+	}
+
+	virtual const std::string name() const {
+		return "tabu";
+	}
+
+	virtual const std::string description() const {
+		return "The Tabu Sampler runs parallel multi-start tabu search locally.";
+	}
+
+	virtual ~TabuSampler() {}
+
+protected:
+
+	/**
+	 * Run the given restarts, each from its initial state in
+	 * states, leaving the best state found by each in place and
+	 * its energy in energies.
+	 */
+	void search(const IsingProblem& problem, std::vector<std::int8_t>& states,
+			std::vector<double>& energies);
+};
+
+}
+}
+
+#endif
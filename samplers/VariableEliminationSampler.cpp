@@ -0,0 +1,343 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <set>
+#include <tuple>
+#include "VariableEliminationSampler.hpp"
+#include "Parallel.hpp"
+
+namespace xacc {
+namespace quantum {
+
+namespace {
+
+/**
+ * A dense factor table over the spins of its scope. Entry
+ * sum_b x_b 2^b, where x_b = 1 if scope[b] is +1, lives at
+ * pool[offset + entry].
+ */
+struct Factor {
+	std::vector<int> scope;
+	std::size_t offset;
+};
+
+/**
+ * A bucket holds the factors whose earliest eliminated variable
+ * is the bucket's variable, and the message it sends on
+ * elimination. The bucket scope is its variable followed by the
+ * message scope, and bitMaps[k][b] is the bit of the bucket scope
+ * holding bit b of factor k.
+ */
+struct Bucket {
+	std::vector<int> factors;
+	std::vector<std::vector<int>> bitMaps;
+	std::vector<int> scope;
+	int message;
+};
+
+/**
+ * Return the index into a factor table of the
+ * given assignment of the bucket scope.
+ */
+inline std::size_t factorIndex(const std::size_t assignment,
+		const std::vector<int>& bitMap) {
+	std::size_t index = 0;
+	for (std::size_t b = 0; b < bitMap.size(); b++) {
+		index |= ((assignment >> bitMap[b]) & 1) << b;
+	}
+	return index;
+}
+
+/**
+ * Return the sum of the bucket's factors at the given
+ * assignment of the bucket scope.
+ */
+inline double evaluateBucket(const Bucket& bucket,
+		const std::vector<Factor>& factors, const std::vector<double>& pool,
+		const std::size_t assignment) {
+	double value = 0.0;
+	for (std::size_t k = 0; k < bucket.factors.size(); k++) {
+		value += pool[factors[bucket.factors[k]].offset
+				+ factorIndex(assignment, bucket.bitMaps[k])];
+	}
+	return value;
+}
+
+/**
+ * Return the number of fill edges eliminating v would add.
+ */
+int fillIn(const std::vector<std::set<int>>& adjacency, const int v) {
+	int fill = 0;
+	for (auto a = adjacency[v].begin(); a != adjacency[v].end(); ++a) {
+		for (auto b = std::next(a); b != adjacency[v].end(); ++b) {
+			if (!adjacency[*a].count(*b)) fill++;
+		}
+	}
+	return fill;
+}
+
+}
+
+std::vector<int> VariableEliminationSampler::getEliminationOrder(
+		const IsingProblem& problem, int& width) {
+
+	const int n = problem.size();
+	std::vector<std::set<int>> adjacency(n);
+	for (auto& c : problem.getCouplings()) {
+		adjacency[c.i].insert(c.j);
+		adjacency[c.j].insert(c.i);
+	}
+
+	std::vector<int> fill(n), order;
+	std::vector<bool> eliminated(n, false);
+	for (int v = 0; v < n; v++) {
+		fill[v] = fillIn(adjacency, v);
+	}
+
+	width = 0;
+	for (int step = 0; step < n; step++) {
+
+		// Greedily take the variable adding the fewest fill
+		// edges, breaking ties by the smallest degree
+		int v = -1;
+		for (int u = 0; u < n; u++) {
+			if (!eliminated[u] && (v < 0 || fill[u] < fill[v]
+					|| (fill[u] == fill[v] && adjacency[u].size() < adjacency[v].size()))) {
+				v = u;
+			}
+		}
+
+		auto neighbors = adjacency[v];
+		width = std::max(width, static_cast<int>(neighbors.size()));
+		for (auto a : neighbors) {
+			adjacency[a].erase(v);
+			for (auto b : neighbors) {
+				if (a != b) adjacency[a].insert(b);
+			}
+		}
+		adjacency[v].clear();
+		eliminated[v] = true;
+		order.push_back(v);
+
+		// Only the neighbors and their neighbors can see their fill change
+		std::set<int> affected(neighbors.begin(), neighbors.end());
+		for (auto a : neighbors) {
+			affected.insert(adjacency[a].begin(), adjacency[a].end());
+		}
+		for (auto a : affected) {
+			fill[a] = fillIn(adjacency, a);
+		}
+	}
+
+	return order;
+}
+
+SampleSet VariableEliminationSampler::sample(const IsingProblem& problem,
+		const DWSamplerParameters& params) {
+
+	int maxWidth = 20;
+	if (xacc::optionExists("dwave-ve-max-width")) {
+		maxWidth = std::stoi(xacc::getOption("dwave-ve-max-width"));
+	}
+
+	const int n = problem.size();
+	int width;
+	auto order = getEliminationOrder(problem, width);
+	if (width > maxWidth) {
+		xacc::error("The variable elimination sampler found an elimination "
+				"order of width " + std::to_string(width) + ", above the "
+				"dwave-ve-max-width limit of " + std::to_string(maxWidth) + ".");
+	}
+
+	std::vector<int> position(n);
+	for (int p = 0; p < n; p++) {
+		position[order[p]] = p;
+	}
+	auto firstEliminated = [&](const std::vector<int>& scope) {
+		int p = n;
+		for (auto v : scope) p = std::min(p, position[v]);
+		return p;
+	};
+
+	// Symbolic pass, place the problem's factors in buckets and
+	// work out the scope of every message, so the whole table
+	// pool can be allocated at once
+	std::vector<Factor> factors;
+	std::vector<Bucket> buckets(n);
+	std::vector<int> constants;
+	std::size_t poolSize = 0;
+	auto addFactor = [&](const std::vector<int>& scope) {
+		factors.push_back( { scope, poolSize });
+		poolSize += std::size_t(1) << scope.size();
+		return static_cast<int>(factors.size()) - 1;
+	};
+
+	auto& biases = problem.getBiases();
+	std::vector<double> coefficients;
+	for (int i = 0; i < n; i++) {
+		if (biases[i] != 0.0) {
+			buckets[position[i]].factors.push_back(addFactor( { i }));
+			coefficients.push_back(biases[i]);
+		}
+	}
+	for (auto& c : problem.getCouplings()) {
+		buckets[std::min(position[c.i], position[c.j])].factors.push_back(
+				addFactor( { c.i, c.j }));
+		coefficients.push_back(c.value);
+	}
+
+	for (int p = 0; p < n; p++) {
+		auto& bucket = buckets[p];
+		auto v = order[p];
+		std::set<int> messageScope;
+		for (auto f : bucket.factors) {
+			for (auto u : factors[f].scope) {
+				if (u != v) messageScope.insert(u);
+			}
+		}
+
+		bucket.scope.push_back(v);
+		bucket.scope.insert(bucket.scope.end(), messageScope.begin(),
+				messageScope.end());
+		for (auto f : bucket.factors) {
+			std::vector<int> bitMap;
+			for (auto u : factors[f].scope) {
+				bitMap.push_back(std::find(bucket.scope.begin(),
+						bucket.scope.end(), u) - bucket.scope.begin());
+			}
+			bucket.bitMaps.push_back(bitMap);
+		}
+
+		std::vector<int> scope(messageScope.begin(), messageScope.end());
+		bucket.message = addFactor(scope);
+		if (scope.empty()) {
+			constants.push_back(bucket.message);
+		} else {
+			buckets[firstEliminated(scope)].factors.push_back(bucket.message);
+		}
+	}
+
+	// Fill in the tables of the problem's own factors, each
+	// entry being the coefficient times the product of the spins
+	std::vector<double> pool(poolSize, 0.0);
+	for (std::size_t f = 0; f < coefficients.size(); f++) {
+		auto size = std::size_t(1) << factors[f].scope.size();
+		for (std::size_t x = 0; x < size; x++) {
+			auto parity = __builtin_popcountll(~x & (size - 1)) & 1;
+			pool[factors[f].offset + x] = parity ? -coefficients[f] : coefficients[f];
+		}
+	}
+
+	// Numeric pass, contract every bucket into its message,
+	// in parallel over the message entries for large tables
+	for (int p = 0; p < n; p++) {
+		auto& bucket = buckets[p];
+		auto& message = factors[bucket.message];
+		auto size = std::size_t(1) << message.scope.size();
+		auto contract = [&](std::size_t begin, std::size_t end) {
+			for (auto c = begin; c < end; c++) {
+				auto down = evaluateBucket(bucket, factors, pool, c << 1);
+				auto up = evaluateBucket(bucket, factors, pool, (c << 1) | 1);
+				pool[message.offset + c] = std::min(down, up);
+			}
+		};
+		if (size >= 4096) {
+			parallelFor(size, 1024, contract);
+		} else {
+			contract(0, size);
+		}
+	}
+
+	// Best first search over partial assignments in reverse
+	// elimination order. The priority of a node is the exact
+	// energy of its best completion, so complete assignments
+	// come off the queue in order of energy.
+	struct Node {
+		double cost;
+		int depth;
+		std::int8_t spin;
+		int parent;
+	};
+	std::vector<Node> nodes;
+	double root = 0.0;
+	for (auto c : constants) {
+		root += pool[factors[c].offset];
+	}
+	nodes.push_back( { root, 0, 0, -1 });
+
+	using Entry = std::tuple<double, int, int>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	queue.push(std::make_tuple(root, 0, 0));
+
+	SampleSet samples(problem.getLabels());
+	std::vector<std::int8_t> spins(n, -1);
+	auto assign = [&](int id) {
+		for (; nodes[id].depth > 0; id = nodes[id].parent) {
+			spins[order[n - nodes[id].depth]] = nodes[id].spin;
+		}
+	};
+
+	while (!queue.empty() && samples.size() < params.numReads) {
+		auto id = std::get<2>(queue.top());
+		queue.pop();
+		auto node = nodes[id];
+		assign(id);
+
+		if (node.depth == n) {
+			samples.append(spins.data(), problem.energy(spins.data()));
+			continue;
+		}
+
+		auto p = n - 1 - node.depth;
+		auto& bucket = buckets[p];
+		std::size_t assignment = 0;
+		for (std::size_t b = 1; b < bucket.scope.size(); b++) {
+			if (spins[bucket.scope[b]] > 0) assignment |= std::size_t(1) << b;
+		}
+		auto lambda = pool[factors[bucket.message].offset + (assignment >> 1)];
+		for (int x = 0; x < 2; x++) {
+			auto cost = node.cost - lambda
+					+ evaluateBucket(bucket, factors, pool, assignment | x);
+			nodes.push_back( { cost, node.depth + 1,
+					static_cast<std::int8_t>(x ? 1 : -1), id });
+			queue.push(std::make_tuple(cost, -(node.depth + 1),
+					static_cast<int>(nodes.size()) - 1));
+		}
+	}
+
+	return samples;
+}
+
+}
+}
@@ -0,0 +1,97 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_SAMPLERS_VARIABLEELIMINATIONSAMPLER_HPP_
+#define XACC_DWAVE_SAMPLERS_VARIABLEELIMINATIONSAMPLER_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The VariableEliminationSampler solves problems of low treewidth
+ * exactly with bucket elimination. Variables are eliminated in a
+ * greedy min-fill order. Eliminating a variable contracts the factors
+ * in its bucket into a min-sum message over its remaining neighbors,
+ * with the table entries computed in parallel. All factor tables are
+ * dense, indexed by the spins of their scope, and allocated up front
+ * in one contiguous pool.
+ *
+ * The messages give the exact cost of the best completion of any
+ * partial assignment made in reverse elimination order, so a best
+ * first search over those partial assignments pops complete ones in
+ * order of energy, and the numReads lowest energy states are returned,
+ * ground states first.
+ */
+class VariableEliminationSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params);
+
+	/**
+	 * Return a min-fill elimination order of the given
+	 * problem's interaction graph, and its induced width.
+	 *
+	 * @param problem The Ising problem
+	 * @param width The induced width of the order
+	 * @return order The variables in elimination order
+	 */
+	std::vector<int> getEliminationOrder(const IsingProblem& problem,
+			int& width);
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		auto desc = std::make_shared<options_description>(
+				"Variable Elimination Sampler Options");
+		desc->add_options()("dwave-ve-max-width", value<std::string>(),
+				"The largest induced width to attempt, default 20. Factor "
+				"tables hold 2^width entries.");
+		return desc;
+	}
+
+	virtual const std::string name() const {
+		return "variable-elimination";
+	}
+
+	virtual const std::string description() const {
+		return "The Variable Elimination Sampler returns exact lowest energy "
+				"states of low treewidth problems with bucket elimination.";
+	}
+
+	virtual ~VariableEliminationSampler() {}
+
+};
+
+}
+}
+
+#endif
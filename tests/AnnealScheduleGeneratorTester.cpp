@@ -31,6 +31,7 @@
 #include <memory>
 #include <gtest/gtest.h>
 #include "DWAccelerator.hpp"
+#include "AnnealingFunctions.hpp"
 
 using namespace xacc::quantum;
 
@@ -46,6 +47,21 @@ TEST(AnnealScheduleGeneratorTester, checkAnnealSched) {
     std::cout << gen.getAsString(as) << "\n";
 }
 
+TEST(AnnealScheduleGeneratorTester, checkAnnealingFunctions) {
+
+    AnnealSchedule as {{0., 0.}, {10., 0.5}, {20., 0.5}, {30., 1.}};
+
+    AnnealingFunctions functions(as, 6.0, 11.0);
+
+    EXPECT_NEAR(30.0, functions.getTotalTime(), 1e-12);
+    EXPECT_NEAR(0.25, functions.getS(5.0), 1e-12);
+    EXPECT_NEAR(0.5, functions.getS(15.0), 1e-12);
+    EXPECT_NEAR(0.75, functions.getS(25.0), 1e-12);
+    EXPECT_NEAR(1.0, functions.getS(40.0), 1e-12);
+    EXPECT_NEAR(3.0, functions.getTransverseField(0.5), 1e-12);
+    EXPECT_NEAR(5.5, functions.getLongitudinalField(0.5), 1e-12);
+}
+
 int main(int argc, char** argv) {
    xacc::Initialize(argc, argv);
    ::testing::InitGoogleTest(&argc, argv);
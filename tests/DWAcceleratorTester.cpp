@@ -28,7 +28,9 @@
  *   Initial API and implementation - Alex McCaskey
  *
  **********************************************************************************/
+#include <map>
 #include <memory>
+#include <set>
 #include <gtest/gtest.h>
 #include "DWAccelerator.hpp"
 
@@ -47,7 +49,228 @@ TEST(DWAcceleratorTester, checkKernelExecution) {
 
 }
 
+/**
+ * A spin glass on the complete bipartite graph between
+ * variables 0-3 and 4-7, as one Chimera cell couples them.
+ */
+std::shared_ptr<DWKernel> cellKernel(const std::string& name) {
+	auto kernel = std::make_shared<DWKernel>(name);
+	for (int i = 0; i < 4; i++) {
+		kernel->addInstruction(std::make_shared<DWQMI>(i, i, 0.1 * (i - 1)));
+		for (int j = 4; j < 8; j++) {
+			kernel->addInstruction(std::make_shared<DWQMI>(i, j,
+					(i * 3 + j) % 4 < 2 ? 1.0 : -1.0));
+		}
+	}
+	return kernel;
+}
+
+/**
+ * A buffer embedding the cellKernel variables
+ * one to one onto the qubits of the first cell.
+ */
+std::shared_ptr<DWAcceleratorBuffer> identityBuffer(DWAccelerator& acc,
+		const std::string& name) {
+	auto buffer = std::dynamic_pointer_cast<DWAcceleratorBuffer>(
+			acc.createBuffer(name, 2048));
+	Embedding embedding;
+	for (int i = 0; i < 8; i++) {
+		embedding.insert(std::make_pair(i, std::vector<int> { i }));
+	}
+	buffer->setEmbedding(embedding);
+	return buffer;
+}
+
+/**
+ * Sets the given options for the lifetime of a test, then
+ * restores their previous values or removes them, so the
+ * tests do not depend on the order they run in.
+ */
+class ScopedOptions {
+public:
+	ScopedOptions(const std::map<std::string, std::string>& options) {
+		auto runtime = xacc::RuntimeOptions::instance();
+		for (auto& kv : options) {
+			if (runtime->exists(kv.first)) {
+				previous.insert(std::make_pair(kv.first, (*runtime)[kv.first]));
+			} else {
+				added.push_back(kv.first);
+			}
+			xacc::setOption(kv.first, kv.second);
+		}
+	}
+
+	~ScopedOptions() {
+		auto runtime = xacc::RuntimeOptions::instance();
+		for (auto& kv : previous) {
+			(*runtime)[kv.first] = kv.second;
+		}
+		for (auto& key : added) {
+			runtime->erase(key);
+		}
+	}
+
+protected:
+	std::map<std::string, std::string> previous;
+	std::vector<std::string> added;
+};
+
+TEST(DWAcceleratorTester, checkRefine) {
+
+	ScopedOptions options( { { "dwave-sampler", "sqa" }, { "dwave-num-reads", "10" },
+			{ "dwave-seed", "11" }, { "dwave-anneal-time", "5" } });
+
+	DWAccelerator acc;
+	acc.initialize();
+	auto dwBuffer = identityBuffer(acc, "refine");
+
+	acc.execute(dwBuffer, cellKernel("forward"));
+	auto& first = dwBuffer->getSamples();
+	auto start = first.getEnergies()[dwBuffer->getSampleIndex().getLowestEnergy(1)[0]];
+	auto nFirst = first.size();
+
+	// The previous result is kept alongside every round
+	auto reverse = cellKernel("reverse");
+	reverse->addInstruction(std::make_shared<Anneal>(
+			std::vector<InstructionParameter> { 2.0, 1.0, 2.0, std::string("reverse") }));
+	acc.refine(dwBuffer, reverse, 3);
+
+	auto& samples = dwBuffer->getSamples();
+	auto lowest = samples.getEnergies()[dwBuffer->getSampleIndex().getLowestEnergy(1)[0]];
+	EXPECT_LE(lowest, start + 1e-12);
+	EXPECT_GE(samples.size(), nFirst);
+	EXPECT_EQ(dwBuffer->getMeasurements().size(), dwBuffer->getEnergies().size());
+	EXPECT_EQ(samples.size(), dwBuffer->getEnergies().size());
+	EXPECT_EQ(samples.size(), dwBuffer->getLogicalSamples().size());
+}
+
+TEST(DWAcceleratorTester, checkReverseTuning) {
+
+	ScopedOptions options( { { "dwave-sampler", "sqa" }, { "dwave-num-reads", "10" },
+			{ "dwave-seed", "13" } });
+
+	DWAccelerator acc;
+	acc.initialize();
+	auto dwBuffer = identityBuffer(acc, "tune");
+	acc.execute(dwBuffer, cellKernel("forward"));
+
+	// A reverse candidate starts from the buffer's result
+	auto objective = acc.getTuningObjective(dwBuffer, cellKernel("tuned"));
+	auto samples = objective( { { 0.0, 1.0 }, { 2.0, 0.5 }, { 4.0, 1.0 } }, 12, 3);
+	int nReads = 0;
+	for (auto n : samples.getNumberOfOccurrences()) {
+		nReads += n;
+	}
+	EXPECT_EQ(12, nReads);
+	EXPECT_EQ(8, samples.getNumberOfVariables());
+}
 
+TEST(DWAcceleratorTester, checkTiledExecution) {
+
+	ScopedOptions options( { { "dwave-sampler", "sqa" }, { "dwave-num-reads", "10" },
+			{ "dwave-seed", "19" }, { "dwave-tile", "true" } });
+
+	// Rings of four variables with different couplings
+	std::vector<std::shared_ptr<Function>> kernels;
+	for (int k = 0; k < 3; k++) {
+		auto kernel = std::make_shared<DWKernel>("ring" + std::to_string(k));
+		for (int i = 0; i < 4; i++) {
+			kernel->addInstruction(std::make_shared<DWQMI>(i, i, 0.2 * (k - i)));
+			kernel->addInstruction(std::make_shared<DWQMI>(i, (i + 1) % 4,
+					(i + k) % 3 == 0 ? -1.0 : 0.5));
+		}
+		kernels.push_back(kernel);
+	}
+
+	DWAccelerator acc;
+	acc.initialize();
+	auto buffer = acc.createBuffer("tiles", 2048);
+	auto buffers = acc.execute(buffer, kernels);
+	ASSERT_EQ(3, buffers.size());
+
+	std::set<int> used;
+	for (int k = 0; k < 3; k++) {
+		auto dwBuffer = std::dynamic_pointer_cast<DWAcceleratorBuffer>(buffers[k]);
+		ASSERT_TRUE(dwBuffer != nullptr);
+		for (auto& kv : dwBuffer->getEmbedding()) {
+			for (auto q : kv.second) {
+				EXPECT_TRUE(used.insert(q).second);
+			}
+		}
+
+		// Every logical sample is scored by its own kernel
+		auto logical = DWAccelerator::toIsingProblem(
+				std::dynamic_pointer_cast<DWKernel>(kernels[k]));
+		auto& samples = dwBuffer->getLogicalSamples();
+		ASSERT_EQ(logical.getLabels(), samples.getLabels());
+		ASSERT_GT(samples.size(), 0);
+		std::vector<std::int8_t> spins(samples.getNumberOfVariables());
+		for (int s = 0; s < samples.size(); s++) {
+			for (int i = 0; i < spins.size(); i++) {
+				spins[i] = samples.getSpin(s, i);
+			}
+			EXPECT_NEAR(logical.energy(spins.data()), samples.getEnergies()[s], 1e-9);
+		}
+	}
+}
+
+TEST(DWAcceleratorTester, checkTabuPostProcessing) {
+
+	ScopedOptions options( { { "dwave-sampler", "sqa" }, { "dwave-num-reads", "10" },
+			{ "dwave-seed", "23" }, { "dwave-post-process", "tabu" } });
+
+	DWAccelerator acc;
+	acc.initialize();
+	auto dwBuffer = identityBuffer(acc, "polished");
+	auto kernel = cellKernel("polished");
+	acc.execute(dwBuffer, kernel);
+
+	// Polishing never raises the energy of a logical sample
+	auto logical = DWAccelerator::toIsingProblem(kernel);
+	auto& samples = dwBuffer->getLogicalSamples();
+	auto& improvements = dwBuffer->getImprovements();
+	ASSERT_EQ(samples.size(), improvements.size());
+	std::vector<std::int8_t> spins(samples.getNumberOfVariables());
+	for (int s = 0; s < samples.size(); s++) {
+		EXPECT_GE(improvements[s], 0.0);
+		samples.getSpins(s, spins.data());
+		EXPECT_NEAR(logical.energy(spins.data()), samples.getEnergies()[s], 1e-9);
+	}
+}
+
+TEST(DWAcceleratorTester, checkAdaptiveSampling) {
+
+	ScopedOptions options( { { "dwave-sampler", "sqa" }, { "dwave-num-reads", "200" },
+			{ "dwave-seed", "17" }, { "dwave-adaptive-chunk-size", "10" } });
+
+	DWAccelerator acc;
+	acc.initialize();
+	auto run = [&](const std::string& name) {
+		auto dwBuffer = identityBuffer(acc, name);
+		acc.execute(dwBuffer, cellKernel(name));
+		return dwBuffer->getSamples();
+	};
+
+	auto first = run("adaptive1");
+	auto second = run("adaptive2");
+	int nReads = 0;
+	for (auto n : first.getNumberOfOccurrences()) {
+		nReads += n;
+	}
+	// Sampling stops in whole chunks once the lowest
+	// energy is seen often enough, well before the budget
+	EXPECT_GT(nReads, 0);
+	EXPECT_EQ(0, nReads % 10);
+	EXPECT_LT(nReads, 200);
+
+	// Chunks are seeded from the run's seed
+	EXPECT_EQ(first.getLabels(), second.getLabels());
+	EXPECT_EQ(first.getEnergies(), second.getEnergies());
+	EXPECT_EQ(first.getNumberOfOccurrences(), second.getNumberOfOccurrences());
+	for (int i = 0; i < first.size(); i++) {
+		EXPECT_EQ(first.getBitset(i), second.getBitset(i));
+	}
+}
 
 int main(int argc, char** argv) {
    xacc::Initialize(argc, argv);
@@ -0,0 +1,117 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <gtest/gtest.h>
+#include "DWAnnealTuner.hpp"
+
+using namespace xacc::quantum;
+
+TEST(DWAnnealTunerTester, checkTune) {
+
+	// Reads reach energy -1 with probability 1 - exp(-(t/30)^2)
+	// for a schedule of length t, so TTS99 is 4145 / t up to
+	// t = 64.4 where p = 0.99, and t after. Each evaluation
+	// checks that several run at once.
+	std::atomic<int> running(0), maxRunning(0);
+	auto objective = [&](const AnnealSchedule& schedule, const int numReads,
+			const std::uint64_t seed) {
+		auto now = ++running;
+		for (auto m = maxRunning.load(); now > m && !maxRunning.compare_exchange_weak(m, now);) {}
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+		auto t = schedule.back().first;
+		auto p = 1.0 - std::exp(-t * t / 900.0);
+		auto hits = static_cast<int>(std::round(p * numReads));
+		std::vector<int> labels {0};
+		std::vector<std::int8_t> up {1}, down {-1};
+		SampleSet samples(labels);
+		if (hits > 0) samples.append(up.data(), -1.0, hits);
+		if (hits < numReads) samples.append(down.data(), 0.0, numReads - hits);
+		running--;
+		return samples;
+	};
+
+	DWAnnealTuner tuner(objective, 1000, 4, 11);
+	tuner.setTimeRange(1.0, 500.0);
+	auto best = tuner.tune(80);
+
+	EXPECT_EQ(80, tuner.getCandidates().size());
+	EXPECT_EQ(-1.0, tuner.getTargetEnergy());
+	EXPECT_LT(1, maxRunning.load());
+	EXPECT_LE(maxRunning.load(), 4);
+	EXPECT_LT(best.tts, 80.0);
+	EXPECT_NEAR(64.4, best.ta + best.tp + best.tq, 20.0);
+	for (auto& c : tuner.getCandidates()) {
+		EXPECT_LE(best.tts, c.tts);
+	}
+}
+
+TEST(DWAnnealTunerTester, checkSynchronous) {
+
+	// With one evaluation in flight the objective runs on the calling
+	// thread, in proposal order, as it must across MPI ranks
+	auto caller = std::this_thread::get_id();
+	int calls = 0;
+	auto objective = [&](const AnnealSchedule& schedule, const int numReads,
+			const std::uint64_t seed) {
+		EXPECT_EQ(caller, std::this_thread::get_id());
+		EXPECT_EQ(std::uint64_t(SplitMix64(5, ++calls).next()), seed);
+		std::vector<int> labels {0};
+		std::vector<std::int8_t> up {1};
+		SampleSet samples(labels);
+		samples.append(up.data(), -schedule.back().first, numReads);
+		return samples;
+	};
+
+	DWAnnealTuner tuner(objective, 10, 1, 5);
+	tuner.tune(6);
+	EXPECT_EQ(6, calls);
+	EXPECT_EQ(6, tuner.getCandidates().size());
+}
+
+TEST(DWAnnealTunerTester, checkSchedule) {
+	AnnealCandidate candidate;
+	candidate.ta = 10.0;
+	auto schedule = candidate.getSchedule();
+	ASSERT_EQ(2, schedule.size());
+	EXPECT_EQ(10.0, schedule.back().first);
+	EXPECT_EQ(1.0, schedule.back().second);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
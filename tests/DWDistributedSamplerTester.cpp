@@ -0,0 +1,112 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <set>
+#include <mpi.h>
+#include <gtest/gtest.h>
+#include "DWDistributedSampler.hpp"
+
+using namespace xacc::quantum;
+
+/**
+ * A sampler whose samples spell out the seed it was given.
+ */
+class SeedSampler : public DWSampler {
+
+public:
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params) {
+		SampleSet samples(problem.getLabels());
+		std::vector<std::int8_t> spins(problem.size());
+		for (int i = 0; i < problem.size(); i++) {
+			spins[i] = ((params.seed >> (i + 1)) & 1) ? 1 : -1;
+		}
+		for (int r = 0; r < params.numReads; r++) {
+			samples.append(spins.data(), problem.energy(spins.data()), 2);
+		}
+		return samples;
+	}
+
+	virtual std::shared_ptr<options_description> getOptions() {
+		return std::make_shared<options_description>("Seed Sampler Options");
+	}
+
+	virtual const std::string name() const {
+		return "seed";
+	}
+
+	virtual const std::string description() const {
+		return "";
+	}
+};
+
+TEST(DWDistributedSamplerTester, checkGather) {
+
+	DWDistributedSampler::isDistributed();
+	int size;
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	std::vector<int> labels;
+	for (int i = 0; i < 70; i++) labels.push_back(i);
+	IsingProblem problem(labels, std::vector<double>(70, 1.0), { });
+
+	DWSamplerParameters params;
+	params.numReads = 11;
+	params.seed = 61;
+
+	DWDistributedSampler sampler(std::make_shared<SeedSampler>());
+	auto samples = sampler.sample(problem, params);
+
+	// All reads come back, each rank's with its own seed
+	EXPECT_EQ(11, samples.size());
+	std::set<std::vector<int>> patterns;
+	for (int s = 0; s < samples.size(); s++) {
+		std::vector<int> pattern;
+		double energy = 0.0;
+		for (int i = 0; i < 70; i++) {
+			pattern.push_back(samples.getSpin(s, i));
+			energy += samples.getSpin(s, i);
+		}
+		patterns.insert(pattern);
+		EXPECT_EQ(2, samples.getNumberOfOccurrences()[s]);
+		EXPECT_DOUBLE_EQ(energy, samples.getEnergies()[s]);
+	}
+	EXPECT_EQ(std::min(size, 11), patterns.size());
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
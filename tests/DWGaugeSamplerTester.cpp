@@ -0,0 +1,122 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <mutex>
+#include <gtest/gtest.h>
+#include "DWGaugeSampler.hpp"
+
+using namespace xacc::quantum;
+
+/**
+ * Aligns every spin against its bias, which for problems
+ * without couplings is the ground state, and records the
+ * problems it was given.
+ */
+class FieldSampler : public DWSampler {
+public:
+	std::mutex mutex;
+	std::vector<std::vector<double>> biases;
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			biases.push_back(problem.getBiases());
+		}
+		std::vector<std::int8_t> spins(problem.size());
+		for (int i = 0; i < problem.size(); i++) {
+			spins[i] = problem.getBiases()[i] > 0.0 ? -1 : 1;
+		}
+		SampleSet samples(problem.getLabels());
+		samples.append(spins.data(), problem.energy(spins.data()), params.numReads);
+		return samples;
+	}
+	virtual std::shared_ptr<options_description> getOptions() {
+		return std::make_shared<options_description>("Field");
+	}
+	virtual const std::string name() const {
+		return "field";
+	}
+	virtual const std::string description() const {
+		return "";
+	}
+};
+
+TEST(DWGaugeSamplerTester, checkGauges) {
+
+	// 100 qubits with positive biases, so all down is the ground state
+	std::vector<int> labels;
+	std::vector<double> h;
+	for (int i = 0; i < 100; i++) {
+		labels.push_back(3 * i);
+		h.push_back(0.5 + 0.01 * i);
+	}
+	IsingProblem problem(labels, h, {});
+	std::vector<std::int8_t> down(100, -1);
+	auto ground = problem.energy(down.data());
+
+	auto field = std::make_shared<FieldSampler>();
+	DWGaugeSampler sampler(field, 5, 2);
+	DWSamplerParameters params;
+	params.numReads = 103;
+	params.seed = 9;
+	auto samples = sampler.sample(problem, params);
+
+	// Every gauge saw a different problem, and
+	// every sample maps back to the ground state
+	ASSERT_EQ(5, field->biases.size());
+	for (int k = 1; k < 5; k++) {
+		EXPECT_NE(field->biases[0], field->biases[k]);
+	}
+	ASSERT_EQ(5, samples.size());
+	int reads = 0;
+	std::vector<std::int8_t> spins(100);
+	for (int s = 0; s < samples.size(); s++) {
+		samples.getSpins(s, spins.data());
+		EXPECT_EQ(down, spins);
+		EXPECT_NEAR(ground, samples.getEnergies()[s], 1e-12);
+		reads += samples.getNumberOfOccurrences()[s];
+	}
+	EXPECT_EQ(103, reads);
+
+	// Gauges are a function of the seed
+	EXPECT_EQ(DWGaugeSampler::getGauge(problem, 9, 3),
+			DWGaugeSampler::getGauge(problem, 9, 3));
+	EXPECT_NE(DWGaugeSampler::getGauge(problem, 9, 3),
+			DWGaugeSampler::getGauge(problem, 10, 3));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,193 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include "DWHedgingSampler.hpp"
+
+using namespace xacc::quantum;
+
+/**
+ * Waits in a queue and then runs for the given times in
+ * milliseconds, like a remote job, honoring its control.
+ */
+class FakeRemoteSampler : public DWRemoteSampler {
+public:
+	int queueTime, runTime;
+	std::atomic<int> calls {0}, cancelled {0};
+
+	FakeRemoteSampler(const int queue, const int run) :
+			DWRemoteSampler(nullptr, "", {}), queueTime(queue), runTime(run) {
+	}
+
+	using DWRemoteSampler::sample;
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params, DWJobControl* control) {
+		calls++;
+		for (int t = 0; t < queueTime; t++) {
+			if (control && control->cancelled) {
+				cancelled++;
+				return SampleSet();
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		if (control && control->onStart) {
+			control->onStart();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(runTime));
+		std::vector<std::int8_t> spins(problem.size(), 1);
+		SampleSet samples(problem.getLabels());
+		samples.append(spins.data(), problem.energy(spins.data()), params.numReads);
+		return samples;
+	}
+};
+
+DWSolver makeSolver(const std::string& name) {
+	DWSolver solver;
+	solver.name = name;
+	solver.nQubits = 2;
+	solver.edges = { {0, 1}};
+	return solver;
+}
+
+IsingProblem makeProblem() {
+	return IsingProblem(std::vector<int> {0, 1}, std::vector<double> {0.5, 0.0},
+			std::vector<IsingCoupling> { {0, 1, -1.0}});
+}
+
+TEST(DWHedgingSamplerTester, checkNoHedge) {
+
+	// The primary starts well before the default deadline
+	auto statistics = std::make_shared<DWSolverStatistics>();
+	auto a = std::make_shared<FakeRemoteSampler>(5, 5);
+	auto b = std::make_shared<FakeRemoteSampler>(0, 0);
+	DWHedgingSampler sampler( {makeSolver("a"), makeSolver("b")}, {a, b}, statistics);
+	EXPECT_EQ(DWHedgingSampler::defaultDeadline, sampler.getDeadline(0));
+
+	DWSamplerParameters params;
+	params.numReads = 10;
+	auto samples = sampler.sample(makeProblem(), params);
+	EXPECT_EQ(10, samples.getNumberOfOccurrences()[0]);
+	EXPECT_EQ(1, a->calls.load());
+	EXPECT_EQ(0, b->calls.load());
+	EXPECT_EQ(1, statistics->getNumberOfHedgeableRequests());
+	EXPECT_EQ(0, statistics->getNumberOfHedges());
+	EXPECT_EQ(0.0, statistics->getHedgeRate());
+
+	// Its queue wait is now the deadline
+	EXPECT_GT(sampler.getDeadline(0), 0.0);
+	EXPECT_LT(sampler.getDeadline(0), DWHedgingSampler::defaultDeadline);
+	EXPECT_EQ(1, statistics->getNumberOfCompletions("a"));
+}
+
+TEST(DWHedgingSamplerTester, checkHedge) {
+
+	// The primary's usual queue wait is 10 ms, but it now waits
+	// much longer, so the job is hedged on b, which answers first
+	auto statistics = std::make_shared<DWSolverStatistics>();
+	statistics->recordStart("a", 0.01);
+	auto a = std::make_shared<FakeRemoteSampler>(2000, 0);
+	auto b = std::make_shared<FakeRemoteSampler>(0, 5);
+	DWHedgingSampler sampler( {makeSolver("a"), makeSolver("b")}, {a, b},
+			statistics, 0.5);
+	EXPECT_EQ(0.01, sampler.getDeadline(0));
+
+	DWSamplerParameters params;
+	params.numReads = 10;
+	auto start = std::chrono::steady_clock::now();
+	auto samples = sampler.sample(makeProblem(), params);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	EXPECT_LT(elapsed.count(), 1.0);
+	EXPECT_EQ(1, samples.size());
+	EXPECT_EQ(10, samples.getNumberOfOccurrences()[0]);
+
+	EXPECT_EQ(1, a->calls.load());
+	EXPECT_EQ(1, a->cancelled.load());
+	EXPECT_EQ(1, b->calls.load());
+	EXPECT_EQ(1, statistics->getNumberOfHedges());
+	EXPECT_EQ(1, statistics->getNumberOfHedgeWins());
+	EXPECT_EQ(1.0, statistics->getHedgeRate());
+	EXPECT_EQ(10, statistics->getHedgeReads());
+	EXPECT_EQ(0, statistics->getNumberOfFailures("a"));
+	EXPECT_EQ(1, statistics->getNumberOfCancellations("a"));
+	EXPECT_EQ(1, statistics->getNumberOfCompletions("b"));
+	EXPECT_EQ(0, statistics->getNumberOfInFlight("a"));
+	EXPECT_EQ(0, statistics->getNumberOfInFlight("b"));
+}
+
+TEST(DWHedgingSamplerTester, checkAbandonedWaits) {
+
+	// The primary keeps waiting longer than its deadline, so every
+	// job is hedged. The waits of the abandoned jobs are kept as
+	// lower bounds, so the deadline grows instead of shrinking.
+	auto statistics = std::make_shared<DWSolverStatistics>();
+	statistics->recordStart("a", 0.01);
+	auto a = std::make_shared<FakeRemoteSampler>(2000, 0);
+	auto b = std::make_shared<FakeRemoteSampler>(0, 5);
+	DWHedgingSampler sampler( {makeSolver("a"), makeSolver("b")}, {a, b},
+			statistics, 0.5);
+
+	DWSamplerParameters params;
+	auto deadline = sampler.getDeadline(0);
+	for (int r = 0; r < 5; r++) {
+		EXPECT_EQ(1, sampler.sample(makeProblem(), params).size());
+		EXPECT_GE(sampler.getDeadline(0), deadline);
+		deadline = sampler.getDeadline(0);
+	}
+	EXPECT_GT(deadline, 0.01);
+	EXPECT_EQ(5, statistics->getNumberOfHedges());
+	EXPECT_EQ(5, statistics->getNumberOfCancellations("a"));
+	EXPECT_EQ(0, statistics->getNumberOfFailures("a"));
+	EXPECT_EQ(0, statistics->getNumberOfInFlight("a"));
+}
+
+TEST(DWHedgingSamplerTester, checkSingleSolver) {
+
+	// Nothing to hedge on, so the job just waits
+	auto statistics = std::make_shared<DWSolverStatistics>();
+	statistics->recordStart("a", 0.001);
+	auto a = std::make_shared<FakeRemoteSampler>(20, 0);
+	DWHedgingSampler sampler( {makeSolver("a")}, {a}, statistics);
+
+	DWSamplerParameters params;
+	EXPECT_EQ(1, sampler.sample(makeProblem(), params).size());
+	EXPECT_EQ(0, statistics->getNumberOfHedgeableRequests());
+	EXPECT_EQ(0, a->cancelled.load());
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
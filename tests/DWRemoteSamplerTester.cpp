@@ -0,0 +1,130 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <gtest/gtest.h>
+#include "DWRemoteSampler.hpp"
+
+using namespace xacc::quantum;
+
+/**
+ * A Client answering like SAPI does for a job
+ * that completes after one poll.
+ */
+class FakeSAPIClient : public xacc::Client {
+
+public:
+
+	std::string posted;
+
+	const std::string post(const std::string& remoteUrl,
+			const std::string& path, const std::string& postStr,
+			std::map<std::string, std::string> headers = std::map<std::string,
+					std::string> { }) {
+		posted = postStr;
+		return "[{\"id\" : \"job\", \"status\" : \"PENDING\"}]";
+	}
+
+	const std::string get(const std::string& remoteUrl,
+			const std::string& path, std::map<std::string, std::string> headers =
+					std::map<std::string, std::string> { }) {
+		// Two samples over qubits 0 and 4, (+1, -1) and (-1, +1)
+		return "{\"status\" : \"COMPLETED\", \"answer\" : {"
+				"\"active_variables\" : [0, 4], \"energies\" : [-1.5, 0.5], "
+				"\"num_occurrences\" : [3, 1], \"solutions\" : \"gEA=\"}}";
+	}
+};
+
+IsingProblem twoQubitProblem() {
+	return IsingProblem(std::vector<int> { 0, 4 }, std::vector<double> { 0.5, 0.0 },
+			std::vector<IsingCoupling> { { 0, 1, -1.0 } }, 0.25);
+}
+
+TEST(DWRemoteSamplerTester, checkProblemJson) {
+
+	DWSolver solver;
+	solver.name = "TEST";
+	solver.nQubits = 8;
+	DWRemoteSampler sampler(std::make_shared<FakeSAPIClient>(), "url", { });
+	sampler.setSolver(solver);
+
+	DWSamplerParameters params;
+	params.numReads = 10;
+	params.schedule = { { 0.0, 0.0 }, { 20.0, 1.0 } };
+
+	EXPECT_EQ("[{ \"solver\" : \"TEST\", \"type\" : \"ising\", \"data\" : "
+			"\"8 3\\n0 0 0.500000\\n4 4 0.000000\\n0 4 -1.000000\\n\", "
+			"\"params\": { \"num_reads\" : 10, \"anneal_schedule\" : "
+			"[[0,0],[20,1]], \"auto_scale\" : true } }]",
+			sampler.getProblemJson(twoQubitProblem(), params));
+
+	// A reverse anneal from qubit 0 up and qubit 4 down
+	params.schedule = { { 0.0, 1.0 }, { 5.0, 0.5 }, { 10.0, 1.0 } };
+	params.initialState = { 1, -1 };
+	EXPECT_EQ("[{ \"solver\" : \"TEST\", \"type\" : \"ising\", \"data\" : "
+			"\"8 3\\n0 0 0.500000\\n4 4 0.000000\\n0 4 -1.000000\\n\", "
+			"\"params\": { \"num_reads\" : 10, \"anneal_schedule\" : "
+			"[[0,1],[5,0.5],[10,1]], \"initial_state\" : [1,3,3,3,-1,3,3,3], "
+			"\"reinitialize_state\" : true, \"auto_scale\" : true } }]",
+			sampler.getProblemJson(twoQubitProblem(), params));
+}
+
+TEST(DWRemoteSamplerTester, checkSamples) {
+
+	auto client = std::make_shared<FakeSAPIClient>();
+	DWRemoteSampler sampler(client, "url", { });
+	DWSolver solver;
+	solver.name = "TEST";
+	solver.nQubits = 8;
+	sampler.setSolver(solver);
+
+	DWSamplerParameters params;
+	params.schedule = { { 0.0, 0.0 }, { 20.0, 1.0 } };
+	auto samples = sampler.sample(twoQubitProblem(), params);
+	EXPECT_FALSE(client->posted.empty());
+
+	EXPECT_EQ(2, samples.size());
+	EXPECT_EQ((std::vector<int> { 0, 4 }), samples.getLabels());
+	EXPECT_EQ((std::vector<int> { 3, 1 }), samples.getNumberOfOccurrences());
+	EXPECT_NEAR(-1.25, samples.getEnergies()[0], 1e-12);
+	EXPECT_NEAR(0.75, samples.getEnergies()[1], 1e-12);
+	EXPECT_EQ(1, samples.getSpin(0, 0));
+	EXPECT_EQ(-1, samples.getSpin(0, 1));
+	EXPECT_EQ(-1, samples.getSpin(1, 0));
+	EXPECT_EQ(1, samples.getSpin(1, 1));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,176 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <atomic>
+#include <thread>
+#include <gtest/gtest.h>
+#include "DWRoutingSampler.hpp"
+
+using namespace xacc::quantum;
+
+/**
+ * Returns one all-up sample after the given
+ * delay, counting the calls it gets.
+ */
+class FakeSampler : public DWSampler {
+public:
+	int delay;
+	std::atomic<int> calls {0};
+
+	FakeSampler(const int milliseconds) : delay(milliseconds) {}
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params) {
+		calls++;
+		std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+		std::vector<std::int8_t> spins(problem.size(), 1);
+		SampleSet samples(problem.getLabels());
+		samples.append(spins.data(), problem.energy(spins.data()));
+		return samples;
+	}
+	virtual std::shared_ptr<options_description> getOptions() {
+		return std::make_shared<options_description>("Fake");
+	}
+	virtual const std::string name() const {
+		return "fake";
+	}
+	virtual const std::string description() const {
+		return "";
+	}
+};
+
+DWSolver makeSolver(const std::string& name,
+		const std::vector<std::pair<int, int>>& edges) {
+	DWSolver solver;
+	solver.name = name;
+	solver.nQubits = 4;
+	solver.edges = edges;
+	return solver;
+}
+
+TEST(DWRoutingSamplerTester, checkStatistics) {
+
+	DWSolverStatistics statistics(4);
+	EXPECT_EQ(-1.0, statistics.getLatencyQuantile("a", 0.5));
+
+	statistics.recordSubmission("a");
+	statistics.recordSubmission("a");
+	EXPECT_EQ(2, statistics.getNumberOfInFlight("a"));
+	statistics.recordCompletion("a", 3.0);
+	statistics.recordFailure("a");
+	EXPECT_EQ(0, statistics.getNumberOfInFlight("a"));
+	EXPECT_EQ(1, statistics.getNumberOfCompletions("a"));
+	EXPECT_EQ(1, statistics.getNumberOfFailures("a"));
+
+	// Only the last 4 latencies are kept
+	for (auto l : {1.0, 2.0, 4.0, 5.0}) {
+		statistics.recordSubmission("a");
+		statistics.recordCompletion("a", l);
+	}
+	EXPECT_EQ(1.0, statistics.getLatencyQuantile("a", 0.0));
+	EXPECT_EQ(2.0, statistics.getLatencyQuantile("a", 0.5));
+	EXPECT_EQ(5.0, statistics.getLatencyQuantile("a", 1.0));
+
+	statistics.recordSubmission("b");
+	statistics.recordCompletion("b", 10.0);
+	EXPECT_EQ(10.0, statistics.getLatencyQuantile("", 1.0));
+	EXPECT_EQ(4.0, statistics.getLatencyQuantile("", 0.6));
+}
+
+TEST(DWRoutingSamplerTester, checkFit) {
+
+	// Only the first solver has the 0 - 1 coupler
+	auto statistics = std::make_shared<DWSolverStatistics>();
+	auto a = std::make_shared<FakeSampler>(0), b = std::make_shared<FakeSampler>(0);
+	DWRoutingSampler sampler( { makeSolver("a", { {0, 1}, {1, 2}}),
+			makeSolver("b", { {1, 2}, {2, 3}, {0, 3}}) }, {a, b}, statistics);
+
+	IsingProblem coupled(std::vector<int> {0, 1}, std::vector<double> {0.5, 0.0},
+			std::vector<IsingCoupling> { {0, 1, -1.0}});
+	IsingProblem free(std::vector<int> {2, 3}, std::vector<double> {0.5, 0.5},
+			std::vector<IsingCoupling> {});
+	EXPECT_TRUE(sampler.fits(0, coupled));
+	EXPECT_FALSE(sampler.fits(1, coupled));
+	EXPECT_FALSE(sampler.fits(0, free));
+	EXPECT_TRUE(sampler.fits(1, free));
+
+	DWSamplerParameters params;
+	for (int i = 0; i < 3; i++) {
+		sampler.sample(coupled, params);
+	}
+	EXPECT_EQ(3, a->calls.load());
+	EXPECT_EQ(0, b->calls.load());
+	EXPECT_EQ(3, statistics->getNumberOfCompletions("a"));
+}
+
+TEST(DWRoutingSamplerTester, checkRouting) {
+
+	// Both solvers fit, b answers ten times slower
+	auto statistics = std::make_shared<DWSolverStatistics>();
+	auto a = std::make_shared<FakeSampler>(2), b = std::make_shared<FakeSampler>(20);
+	std::vector<std::pair<int, int>> edges = { {0, 1}};
+	DWRoutingSampler sampler( {makeSolver("a", edges), makeSolver("b", edges)},
+			{a, b}, statistics);
+	IsingProblem problem(std::vector<int> {0, 1}, std::vector<double> {0.5, 0.0},
+			std::vector<IsingCoupling> { {0, 1, -1.0}});
+
+	// Without history the load breaks the tie
+	DWSolver busy = makeSolver("a", edges);
+	busy.averageLoad = 0.5;
+	DWRoutingSampler loaded( {busy, makeSolver("b", edges)}, {a, b},
+			std::make_shared<DWSolverStatistics>());
+	EXPECT_EQ(1, loaded.route(problem));
+
+	// Once both have history, the faster solver is taken
+	DWSamplerParameters params;
+	sampler.sample(problem, params);
+	statistics->recordSubmission("b");
+	statistics->recordCompletion("b", 0.02);
+	EXPECT_EQ(0, sampler.route(problem));
+	for (int i = 0; i < 5; i++) {
+		sampler.sample(problem, params);
+	}
+	EXPECT_EQ(6, a->calls.load());
+	EXPECT_EQ(0, b->calls.load());
+
+	// A queue on the faster solver sends jobs to the slower one
+	for (int i = 0; i < 20; i++) {
+		statistics->recordSubmission("a");
+	}
+	EXPECT_EQ(1, sampler.route(problem));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
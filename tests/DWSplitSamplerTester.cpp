@@ -0,0 +1,110 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <gtest/gtest.h>
+#include "DWSplitSampler.hpp"
+
+using namespace xacc::quantum;
+
+/**
+ * Returns every read as its own all-up sample,
+ * recording the reads of each call.
+ */
+class FakeSampler : public DWSampler {
+public:
+	std::mutex mutex;
+	std::vector<int> calls;
+	std::atomic<int> running {0}, maxRunning {0};
+
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params) {
+		auto now = ++running;
+		for (auto m = maxRunning.load(); now > m && !maxRunning.compare_exchange_weak(m, now);) {}
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			calls.push_back(params.numReads);
+		}
+		std::vector<std::int8_t> spins(problem.size(), 1);
+		SampleSet samples(problem.getLabels());
+		for (int r = 0; r < params.numReads; r++) {
+			samples.append(spins.data(), problem.energy(spins.data()));
+		}
+		running--;
+		return samples;
+	}
+	virtual std::shared_ptr<options_description> getOptions() {
+		return std::make_shared<options_description>("Fake");
+	}
+	virtual const std::string name() const {
+		return "fake";
+	}
+	virtual const std::string description() const {
+		return "";
+	}
+};
+
+TEST(DWSplitSamplerTester, checkSplit) {
+
+	IsingProblem problem(std::vector<int> {0, 4}, std::vector<double> {0.5, 0.0},
+			std::vector<IsingCoupling> { {0, 1, -1.0}});
+	auto fake = std::make_shared<FakeSampler>();
+
+	// 100 reads per job, or 1000 us / (20 us + 30 us) = 20 reads
+	DWSplitSampler sampler(fake, 100, 1000.0, 30.0, 3);
+	DWSamplerParameters params;
+	params.schedule = { {0.0, 0.0}, {20.0, 1.0}};
+	EXPECT_EQ(20, sampler.getReadsPerJob(params));
+
+	params.numReads = 15;
+	EXPECT_EQ(15, sampler.sample(problem, params).size());
+	EXPECT_EQ(std::vector<int> {15}, fake->calls);
+
+	fake->calls.clear();
+	params.numReads = 205;
+	auto samples = sampler.sample(problem, params);
+	EXPECT_EQ(205, samples.size());
+	EXPECT_EQ(11, fake->calls.size());
+	for (auto c : fake->calls) {
+		EXPECT_TRUE(c == 18 || c == 19);
+	}
+	EXPECT_EQ(3, fake->maxRunning.load());
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,99 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <random>
+#include <gtest/gtest.h>
+#include "EnergyEvaluator.hpp"
+
+using namespace xacc::quantum;
+
+TEST(EnergyEvaluatorTester, checkIsingEnergies) {
+
+	// A sparse problem over 100 variables, so rows span two words
+	std::mt19937 rng(81);
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::vector<int> labels;
+	std::vector<double> h;
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 100; i++) {
+		labels.push_back(2 * i);
+		h.push_back(uniform(rng));
+		J.push_back( { i, (i + 7) % 100, uniform(rng) });
+	}
+	IsingProblem problem(labels, h, J, 1.5);
+
+	// Samples over the same variables in reverse column order
+	std::vector<int> sampleLabels(labels.rbegin(), labels.rend());
+	SampleSet samples(sampleLabels);
+	std::vector<std::vector<std::int8_t>> configurations;
+	for (int s = 0; s < 150; s++) {
+		std::vector<std::int8_t> spins(100), reversed(100);
+		for (int i = 0; i < 100; i++) {
+			spins[i] = uniform(rng) > 0.0 ? 1 : -1;
+			reversed[99 - i] = spins[i];
+		}
+		samples.append(reversed.data(), 0.0);
+		configurations.push_back(spins);
+	}
+
+	xacc::setOption("dwave-num-threads", "2");
+	EnergyEvaluator evaluator(problem, sampleLabels);
+	auto energies = evaluator.evaluate(samples);
+	EXPECT_EQ(150, energies.size());
+	for (int s = 0; s < 150; s++) {
+		EXPECT_NEAR(problem.energy(configurations[s].data()), energies[s], 1e-9);
+	}
+}
+
+TEST(EnergyEvaluatorTester, checkQUBOEnergies) {
+
+	// x0 + 2 x1 - 3 x0 x1 at x = (1, 1) and (0, 1)
+	auto problem = IsingProblem::fromQUBO(std::vector<int> { 0, 1 },
+			std::vector<double> { 1.0, 2.0 },
+			std::vector<IsingCoupling> { { 0, 1, -3.0 } });
+
+	SampleSet samples(std::vector<int> { 0, 1 });
+	std::vector<std::int8_t> both { 1, 1 }, second { -1, 1 };
+	samples.append(both.data(), 0.0);
+	samples.append(second.data(), 0.0);
+
+	EnergyEvaluator(problem, samples.getLabels()).update(samples);
+	EXPECT_NEAR(0.0, samples.getEnergies()[0], 1e-12);
+	EXPECT_NEAR(2.0, samples.getEnergies()[1], 1e-12);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
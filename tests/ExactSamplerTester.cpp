@@ -0,0 +1,157 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <memory>
+#include <random>
+#include <gtest/gtest.h>
+#include "ExactSampler.hpp"
+
+using namespace xacc::quantum;
+
+IsingProblem randomProblem(const int n, const double density, const unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::vector<int> labels;
+	std::vector<double> h(n);
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < n; i++) {
+		labels.push_back(i);
+		h[i] = uniform(rng);
+		for (int j = i + 1; j < n; j++) {
+			if (std::fabs(uniform(rng)) < density) {
+				J.push_back( { i, j, uniform(rng) });
+			}
+		}
+	}
+	return IsingProblem(labels, h, J);
+}
+
+std::vector<double> allEnergies(const IsingProblem& problem) {
+	auto n = problem.size();
+	std::vector<std::int8_t> spins(n);
+	std::vector<double> energies;
+	for (long x = 0; x < (1L << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		energies.push_back(problem.energy(spins.data()));
+	}
+	return energies;
+}
+
+TEST(ExactSamplerTester, checkLowestStates) {
+
+	// Both the dense and the sparse field updates
+	for (auto density : { 1.0, 0.2 }) {
+		auto problem = randomProblem(12, density, 21);
+		auto energies = allEnergies(problem);
+		std::sort(energies.begin(), energies.end());
+
+		xacc::setOption("dwave-exact-mode", "ground");
+		DWSamplerParameters params;
+		params.numReads = 8;
+
+		ExactSampler sampler;
+		auto samples = sampler.sample(problem, params);
+
+		EXPECT_EQ(8, samples.size());
+		for (int i = 0; i < 8; i++) {
+			EXPECT_NEAR(energies[i], samples.getEnergies()[i], 1e-8);
+		}
+	}
+}
+
+TEST(ExactSamplerTester, checkDegenerateGroundStates) {
+
+	// An antiferromagnetic triangle has 6 ground states
+	IsingProblem problem(std::vector<int> { 0, 1, 2 }, std::vector<double>(3, 0.0),
+			std::vector<IsingCoupling> { { 0, 1, 1.0 }, { 1, 2, 1.0 }, { 0, 2, 1.0 } });
+
+	xacc::setOption("dwave-exact-mode", "ground");
+	DWSamplerParameters params;
+	params.numReads = 8;
+
+	ExactSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	int nGround = 0;
+	for (auto e : samples.getEnergies()) {
+		if (std::fabs(e + 1.0) < 1e-8) nGround++;
+	}
+	EXPECT_EQ(6, nGround);
+}
+
+TEST(ExactSamplerTester, checkPartitionFunction) {
+
+	auto problem = randomProblem(10, 0.5, 22);
+	auto beta = 0.7;
+
+	double Z = 0.0;
+	for (auto e : allEnergies(problem)) Z += std::exp(-beta * e);
+
+	ExactSampler sampler;
+	EXPECT_NEAR(std::log(Z), sampler.logPartitionFunction(problem, beta), 1e-8);
+}
+
+TEST(ExactSamplerTester, checkBoltzmannSamples) {
+
+	auto problem = randomProblem(3, 1.0, 23);
+	auto beta = 1.0;
+	auto energies = allEnergies(problem);
+	double Z = 0.0;
+	for (auto e : energies) Z += std::exp(-beta * e);
+
+	xacc::setOption("dwave-exact-mode", "boltzmann");
+	xacc::setOption("dwave-exact-beta", "1.0");
+	DWSamplerParameters params;
+	params.numReads = 20000;
+	params.seed = 24;
+
+	ExactSampler sampler;
+	auto samples = sampler.sample(problem, params);
+	EXPECT_EQ(20000, samples.size());
+
+	std::vector<double> frequencies(8, 0.0);
+	for (int i = 0; i < samples.size(); i++) {
+		int x = 0;
+		for (int j = 0; j < 3; j++) x |= samples.getBit(i, j) << j;
+		frequencies[x] += 1.0 / samples.size();
+	}
+	for (int x = 0; x < 8; x++) {
+		EXPECT_NEAR(std::exp(-beta * energies[x]) / Z, frequencies[x], 0.015);
+	}
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
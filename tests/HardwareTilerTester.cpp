@@ -0,0 +1,123 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <gtest/gtest.h>
+#include "HardwareTiler.hpp"
+
+using namespace xacc::quantum;
+
+// A 4 x 4 grid, qubit 4 * r + c
+std::vector<std::pair<int, int>> gridEdges() {
+	std::vector<std::pair<int, int>> edges;
+	for (int r = 0; r < 4; r++) {
+		for (int c = 0; c < 4; c++) {
+			if (c + 1 < 4) edges.push_back(std::make_pair(4 * r + c, 4 * r + c + 1));
+			if (r + 1 < 4) edges.push_back(std::make_pair(4 * r + c, 4 * r + c + 4));
+		}
+	}
+	return edges;
+}
+
+TEST(HardwareTilerTester, checkRegions) {
+
+	HardwareTiler tiler(16, gridEdges());
+	EXPECT_EQ(16, tiler.getNumberOfFreeQubits());
+
+	// Breadth-first from qubit 0
+	auto region = tiler.getRegion(3);
+	EXPECT_EQ(std::vector<int>({0, 1, 4}), region);
+	auto edges = tiler.getEdges(region);
+	EXPECT_EQ(2, edges.size());
+	EXPECT_EQ(std::make_pair(0, 1), edges[0]);
+	EXPECT_EQ(std::make_pair(0, 2), edges[1]);
+
+	// Allocated qubits are never handed out again
+	tiler.allocate({0, 1, 4, 5});
+	EXPECT_EQ(12, tiler.getNumberOfFreeQubits());
+	region = tiler.getRegion(4);
+	EXPECT_EQ(std::vector<int>({2, 3, 6, 7}), region);
+	tiler.allocate(region);
+
+	// The rest of the grid, and no more
+	region = tiler.getRegion(100);
+	EXPECT_EQ(8, region.size());
+	EXPECT_EQ(8, region.front());
+	tiler.allocate(region);
+	EXPECT_EQ(0, tiler.getNumberOfFreeQubits());
+	EXPECT_TRUE(tiler.getRegion(1).empty());
+
+	tiler.reset();
+	EXPECT_EQ(16, tiler.getNumberOfFreeQubits());
+}
+
+TEST(HardwareTilerTester, checkDisconnectedRegions) {
+
+	// Two components, {0, 1} and {2, 3, 4}
+	HardwareTiler tiler(5, { {0, 1}, {2, 3}, {3, 4} });
+	EXPECT_EQ(std::vector<int>({0, 1, 2}), tiler.getRegion(3));
+	tiler.allocate({0, 1});
+	EXPECT_EQ(std::vector<int>({2, 3}), tiler.getRegion(2));
+}
+
+TEST(HardwareTilerTester, checkSelect) {
+
+	// Two tiles side by side, over qubits 3, 70 and 5, 100
+	std::vector<int> labels = {3, 5, 70, 100};
+	SampleSet samples(labels);
+	std::vector<std::int8_t> a = {1, -1, -1, 1}, b = {-1, 1, 1, 1};
+	samples.append(a.data(), -2.0, 3);
+	samples.append(b.data(), 1.0, 1);
+
+	auto first = HardwareTiler::select(samples, {3, 70});
+	EXPECT_EQ(std::vector<int>({3, 70}), first.getLabels());
+	EXPECT_EQ(2, first.size());
+	EXPECT_EQ(1, first.getSpin(0, 0));
+	EXPECT_EQ(-1, first.getSpin(0, 1));
+	EXPECT_EQ(-1, first.getSpin(1, 0));
+	EXPECT_EQ(1, first.getSpin(1, 1));
+	EXPECT_EQ(-2.0, first.getEnergies()[0]);
+	EXPECT_EQ(3, first.getNumberOfOccurrences()[0]);
+
+	// Unsampled labels are left out
+	auto second = HardwareTiler::select(samples, {100, 5, 8});
+	EXPECT_EQ(std::vector<int>({100, 5}), second.getLabels());
+	EXPECT_EQ(1, second.getSpin(0, 0));
+	EXPECT_EQ(-1, second.getSpin(0, 1));
+	EXPECT_EQ(1, second.getSpin(1, 0));
+	EXPECT_EQ(1, second.getSpin(1, 1));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,103 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <gtest/gtest.h>
+#include "PopulationAnnealingSampler.hpp"
+
+using namespace xacc::quantum;
+
+TEST(PopulationAnnealingSamplerTester, checkFerromagneticChain) {
+
+	// A ferromagnetic chain with a field on its first spin
+	// has the all -1 ground state
+	std::vector<int> labels;
+	std::vector<double> h(10, 0.0);
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 10; i++) {
+		labels.push_back(i);
+		if (i > 0) J.push_back( { i - 1, i, -1.0 });
+	}
+	h[0] = 0.5;
+	IsingProblem problem(labels, h, J);
+
+	DWSamplerParameters params;
+	params.numReads = 10;
+	params.seed = 42;
+
+	PopulationAnnealingSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	// At the default cold temperature the all +1 state, one
+	// unit of energy higher, still holds about 1% of the population
+	EXPECT_EQ(10, samples.size());
+	int nGround = 0;
+	for (int i = 0; i < samples.size(); i++) {
+		if (std::fabs(samples.getEnergies()[i] + 9.5) < 1e-8) {
+			nGround++;
+			for (int j = 0; j < 10; j++) {
+				EXPECT_EQ(-1, samples.getSpin(i, j));
+			}
+		}
+	}
+	EXPECT_GE(nGround, 8);
+}
+
+TEST(PopulationAnnealingSamplerTester, checkBoltzmannStatistics) {
+
+	// A single spin with h = 1 at beta = 0.5 is +1
+	// with probability 1 / (1 + e) = 0.2689
+	IsingProblem problem(std::vector<int> { 0 }, std::vector<double> { 1.0 },
+			std::vector<IsingCoupling> { });
+
+	xacc::setOption("dwave-pa-beta-range", "0.1,0.5");
+
+	DWSamplerParameters params;
+	params.numReads = 4000;
+	params.seed = 7;
+
+	PopulationAnnealingSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	int nUp = 0;
+	for (int i = 0; i < samples.size(); i++) {
+		if (samples.getSpin(i, 0) == 1) nUp++;
+	}
+
+	EXPECT_NEAR(0.2689, double(nUp) / samples.size(), 0.03);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,84 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <numeric>
+#include <random>
+#include <gtest/gtest.h>
+#include "SampleAggregation.hpp"
+
+using namespace xacc::quantum;
+
+TEST(SampleAggregationTester, checkAggregate) {
+
+	// 5000 reads drawn from 20 distinct rows over 90 variables
+	std::mt19937 rng(91);
+	std::vector<int> labels(90);
+	std::iota(labels.begin(), labels.end(), 0);
+	std::vector<std::vector<std::int8_t>> rows(20, std::vector<std::int8_t>(90));
+	for (auto& row : rows) {
+		for (auto& s : row) s = (rng() & 1) ? 1 : -1;
+	}
+
+	SampleSet samples(labels);
+	std::vector<int> counts(20, 0);
+	for (int r = 0; r < 5000; r++) {
+		auto k = rng() % 20;
+		samples.append(rows[k].data(), 1.0 - k % 7, 2);
+		counts[k] += 2;
+	}
+
+	xacc::setOption("dwave-num-threads", "3");
+	auto aggregated = aggregate(samples);
+	EXPECT_EQ(20, aggregated.size());
+
+	int total = 0;
+	std::vector<std::int8_t> spins(90);
+	for (int i = 0; i < aggregated.size(); i++) {
+		if (i > 0) {
+			EXPECT_LE(aggregated.getEnergies()[i - 1], aggregated.getEnergies()[i]);
+		}
+		aggregated.getSpins(i, spins.data());
+		auto k = std::find(rows.begin(), rows.end(), spins) - rows.begin();
+		ASSERT_LT(k, 20);
+		EXPECT_EQ(counts[k], aggregated.getNumberOfOccurrences()[i]);
+		EXPECT_EQ(1.0 - k % 7, aggregated.getEnergies()[i]);
+		total += aggregated.getNumberOfOccurrences()[i];
+	}
+	EXPECT_EQ(10000, total);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,104 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <gtest/gtest.h>
+#include "SampleIndex.hpp"
+
+using namespace xacc::quantum;
+
+TEST(SampleIndexTester, checkTopK) {
+
+	std::mt19937 rng(17);
+	std::vector<int> labels {0, 1, 2};
+	std::vector<std::int8_t> spins {1, -1, 1};
+	SampleSet samples(labels);
+	std::vector<double> energies;
+	std::vector<int> counts;
+	for (int i = 0; i < 500; i++) {
+		energies.push_back(static_cast<int>(rng() % 100) - 50.0);
+		counts.push_back(1 + rng() % 40);
+		samples.append(spins.data(), energies.back(), counts.back());
+	}
+
+	std::vector<int> byEnergy(500), byCount(500);
+	std::iota(byEnergy.begin(), byEnergy.end(), 0);
+	std::iota(byCount.begin(), byCount.end(), 0);
+	std::stable_sort(byEnergy.begin(), byEnergy.end(),
+			[&](int a, int b) {return energies[a] < energies[b];});
+	std::stable_sort(byCount.begin(), byCount.end(), [&](int a, int b) {
+		return counts[a] > counts[b]
+				|| (counts[a] == counts[b] && energies[a] < energies[b]);
+	});
+
+	// Growing k extends the sorted prefix, shrinking it reuses it
+	SampleIndex index(samples);
+	for (int k : {10, 3, 60, 500, 700}) {
+		auto lowest = index.getLowestEnergy(k);
+		auto frequent = index.getMostFrequent(k);
+		auto expected = std::min(k, 500);
+		ASSERT_EQ(expected, lowest.size());
+		ASSERT_EQ(expected, frequent.size());
+		for (int i = 0; i < expected; i++) {
+			EXPECT_EQ(byEnergy[i], lowest[i]);
+			EXPECT_EQ(byCount[i], frequent[i]);
+		}
+	}
+}
+
+TEST(SampleIndexTester, checkQuantiles) {
+
+	// Energies 1, 2, 3 occurring 1, 2 and 7 times
+	std::vector<int> labels {0};
+	std::vector<std::int8_t> spins {1};
+	SampleSet samples(labels);
+	samples.append(spins.data(), 3.0, 7);
+	samples.append(spins.data(), 1.0, 1);
+	samples.append(spins.data(), 2.0, 2);
+
+	SampleIndex index(samples);
+	EXPECT_EQ(1.0, index.getEnergyQuantile(0.0));
+	EXPECT_EQ(1.0, index.getEnergyQuantile(0.1));
+	EXPECT_EQ(2.0, index.getEnergyQuantile(0.25));
+	EXPECT_EQ(2.0, index.getEnergyQuantile(0.3));
+	EXPECT_EQ(3.0, index.getEnergyQuantile(0.5));
+	EXPECT_EQ(3.0, index.getEnergyQuantile(1.0));
+	EXPECT_EQ(std::vector<int>{0}, index.getMostFrequent(1));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,98 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <random>
+#include <gtest/gtest.h>
+#include "SampleStatistics.hpp"
+
+using namespace xacc::quantum;
+
+TEST(SampleStatisticsTester, checkEstimators) {
+
+	// 300 weighted samples over 70 variables, labeled 2k + 1
+	const int n = 70, R = 300;
+	std::mt19937 rng(5);
+	std::vector<int> labels(n);
+	for (int k = 0; k < n; k++) labels[k] = 2 * k + 1;
+
+	SampleSet samples(labels);
+	std::vector<std::vector<std::int8_t>> rows(R, std::vector<std::int8_t>(n));
+	std::vector<int> counts(R);
+	for (int r = 0; r < R; r++) {
+		for (int k = 0; k < n; k++) {
+			rows[r][k] = (rng() % 4 == 0) ? -1 : 1;
+		}
+		counts[r] = 1 + rng() % 9;
+		samples.append(rows[r].data(), 0.0, counts[r]);
+	}
+
+	double W = 0.0;
+	std::vector<double> m(n, 0.0), C(n * n, 0.0);
+	for (int r = 0; r < R; r++) {
+		W += counts[r];
+		for (int i = 0; i < n; i++) {
+			m[i] += counts[r] * rows[r][i];
+			for (int j = 0; j < n; j++) {
+				C[i * n + j] += counts[r] * rows[r][i] * rows[r][j];
+			}
+		}
+	}
+
+	xacc::setOption("dwave-num-threads", "4");
+	SampleStatistics statistics(samples);
+
+	auto magnetizations = statistics.getMagnetizations();
+	ASSERT_EQ(n, magnetizations.size());
+	for (int i = 0; i < n; i++) {
+		EXPECT_NEAR(m[i] / W, magnetizations[i], 1e-12);
+	}
+
+	auto matrix = statistics.getCorrelationMatrix();
+	ASSERT_EQ(n * n, matrix.size());
+	for (int i = 0; i < n * n; i++) {
+		EXPECT_NEAR(C[i] / W, matrix[i], 1e-12);
+	}
+
+	std::vector<std::pair<int, int>> edges {{1, 3}, {139, 1}, {65, 131}, {7, 7}};
+	auto correlations = statistics.getCorrelations(edges);
+	ASSERT_EQ(4, correlations.size());
+	EXPECT_NEAR(C[0 * n + 1] / W, correlations[0], 1e-12);
+	EXPECT_NEAR(C[69 * n + 0] / W, correlations[1], 1e-12);
+	EXPECT_NEAR(C[32 * n + 65] / W, correlations[2], 1e-12);
+	EXPECT_NEAR(1.0, correlations[3], 1e-12);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,102 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <gtest/gtest.h>
+#include "SamplingMonitor.hpp"
+
+using namespace xacc::quantum;
+
+SampleSet chunk(const std::vector<std::pair<double, int>>& reads) {
+	std::vector<int> labels {0};
+	std::vector<std::int8_t> spins {1};
+	SampleSet samples(labels);
+	for (auto& r : reads) {
+		samples.append(spins.data(), r.first, r.second);
+	}
+	return samples;
+}
+
+TEST(SamplingMonitorTester, checkConfidence) {
+
+	SamplingMonitor monitor(10000, 0.99);
+
+	// 10 of 100 reads at -2, a chunk of 100 reads misses that
+	// with probability 0.9^100, but the best just changed
+	monitor.update(chunk({{-2.0, 10}, {-1.0, 60}, {0.0, 30}}));
+	EXPECT_FALSE(monitor.isConverged());
+	EXPECT_EQ(-2.0, monitor.getBestEnergy());
+	EXPECT_NEAR(0.1, monitor.getGroundStateFrequency(), 1e-12);
+
+	// A lower energy resets the count
+	monitor.update(chunk({{-3.0, 1}, {-1.0, 99}}));
+	EXPECT_FALSE(monitor.isConverged());
+	EXPECT_EQ(-3.0, monitor.getBestEnergy());
+	EXPECT_NEAR(1.0 / 200, monitor.getGroundStateFrequency(), 1e-12);
+
+	// Unchanged, but 1 - (1 - 0.01)^100 = 0.63 is not enough
+	monitor.update(chunk({{-3.0, 5}, {-1.0, 95}}));
+	EXPECT_FALSE(monitor.isConverged());
+
+	// Now p = 26 / 400 and 1 - (1 - p)^100 > 0.99
+	monitor.update(chunk({{-3.0, 20}, {-2.0, 80}}));
+	EXPECT_TRUE(monitor.isConverged());
+	EXPECT_EQ(400, monitor.getNumberOfReads());
+	EXPECT_EQ(4, monitor.getNumberOfChunks());
+}
+
+TEST(SamplingMonitorTester, checkToleranceAndBudget) {
+
+	// Energies 0 and 2 in equal proportion: mean 1, standard deviation 1
+	SamplingMonitor monitor(100000, 0.0, 0.05);
+	monitor.update(chunk({{0.0, 50}, {2.0, 50}}));
+	EXPECT_NEAR(1.0, monitor.getMeanEnergy(), 1e-12);
+	EXPECT_NEAR(std::sqrt(100.0 / 99.0 / 100.0), monitor.getStandardError(), 1e-12);
+	EXPECT_FALSE(monitor.isConverged());
+	for (int i = 0; i < 7; i++) {
+		monitor.update(chunk({{0.0, 50}, {2.0, 50}}));
+	}
+	EXPECT_TRUE(monitor.isConverged());
+
+	SamplingMonitor budget(250, 0.0);
+	budget.update(chunk({{0.0, 100}}));
+	budget.update(chunk({{0.0, 100}}));
+	EXPECT_FALSE(budget.isConverged());
+	budget.update(chunk({{0.0, 50}}));
+	EXPECT_TRUE(budget.isConverged());
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,116 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <gtest/gtest.h>
+#include "SimulatedBifurcationSampler.hpp"
+
+using namespace xacc::quantum;
+
+double groundEnergy(const IsingProblem& problem) {
+	auto n = problem.size();
+	std::vector<std::int8_t> spins(n);
+	double best = 1e100;
+	for (long x = 0; x < (1L << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		best = std::min(best, problem.energy(spins.data()));
+	}
+	return best;
+}
+
+TEST(SimulatedBifurcationSamplerTester, checkDenseProblem) {
+
+	// A fully connected Sherrington-Kirkpatrick instance
+	std::mt19937 rng(51);
+	std::normal_distribution<double> normal;
+	std::vector<int> labels;
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 14; i++) {
+		labels.push_back(i);
+		for (int j = i + 1; j < 14; j++) J.push_back( { i, j, normal(rng) });
+	}
+	IsingProblem problem(labels, std::vector<double>(14, 0.0), J);
+	auto ground = groundEnergy(problem);
+
+	for (auto mode : { "ballistic", "discrete" }) {
+		xacc::setOption("dwave-sb-mode", mode);
+		DWSamplerParameters params;
+		params.numReads = 100;
+		params.seed = 52;
+
+		SimulatedBifurcationSampler sampler;
+		auto samples = sampler.sample(problem, params);
+		EXPECT_EQ(100, samples.size());
+		auto& energies = samples.getEnergies();
+		EXPECT_NEAR(ground, *std::min_element(energies.begin(), energies.end()), 1e-8);
+	}
+}
+
+TEST(SimulatedBifurcationSamplerTester, checkSparseProblem) {
+
+	// A biased antiferromagnetic chain uses the CSR rows
+	std::vector<int> labels;
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 30; i++) {
+		labels.push_back(i);
+		if (i > 0) J.push_back( { i - 1, i, 1.0 });
+	}
+	std::vector<double> h(30, 0.0);
+	h[0] = 0.5;
+	IsingProblem problem(labels, h, J);
+
+	xacc::setOption("dwave-sb-mode", "discrete");
+	xacc::setOption("dwave-num-threads", "3");
+	DWSamplerParameters params;
+	params.numReads = 130;
+	params.seed = 53;
+
+	SimulatedBifurcationSampler sampler;
+	auto samples = sampler.sample(problem, params);
+	EXPECT_EQ(130, samples.size());
+	auto& energies = samples.getEnergies();
+	EXPECT_NEAR(-29.5, *std::min_element(energies.begin(), energies.end()), 1e-8);
+
+	// Batches are seeded by index, so threads do not change the result
+	xacc::setOption("dwave-num-threads", "1");
+	auto serial = sampler.sample(problem, params);
+	EXPECT_EQ(energies, serial.getEnergies());
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,123 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <gtest/gtest.h>
+#include "SimulatedQuantumAnnealingSampler.hpp"
+
+using namespace xacc::quantum;
+
+IsingProblem chain(const int n) {
+	std::vector<int> labels;
+	std::vector<double> h(n, 0.0);
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < n; i++) {
+		labels.push_back(i);
+		if (i > 0) J.push_back( { i - 1, i, -1.0 });
+	}
+	h[0] = 0.5;
+	return IsingProblem(labels, h, J);
+}
+
+TEST(SimulatedQuantumAnnealingSamplerTester, checkForwardAnneal) {
+
+	auto problem = chain(8);
+
+	DWSamplerParameters params;
+	params.numReads = 10;
+	params.seed = 11;
+	params.schedule = { { 0.0, 0.0 }, { 20.0, 1.0 } };
+
+	SimulatedQuantumAnnealingSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	EXPECT_EQ(10, samples.size());
+	for (int i = 0; i < samples.size(); i++) {
+		EXPECT_NEAR(-7.5, samples.getEnergies()[i], 1e-8);
+	}
+}
+
+TEST(SimulatedQuantumAnnealingSamplerTester, checkReverseAnneal) {
+
+	auto problem = chain(8);
+
+	// Reverse anneal to s = 0.5, pause, and anneal back
+	DWSamplerParameters params;
+	params.numReads = 10;
+	params.seed = 13;
+	params.schedule = { { 0.0, 1.0 }, { 5.0, 0.5 }, { 10.0, 0.5 }, { 15.0, 1.0 } };
+
+	SimulatedQuantumAnnealingSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	EXPECT_EQ(10, samples.size());
+	std::vector<std::int8_t> spins(problem.size());
+	for (int i = 0; i < samples.size(); i++) {
+		samples.getSpins(i, spins.data());
+		EXPECT_NEAR(problem.energy(spins.data()), samples.getEnergies()[i], 1e-8);
+		EXPECT_NEAR(-7.5, samples.getEnergies()[i], 1e-8);
+	}
+}
+
+TEST(SimulatedQuantumAnnealingSamplerTester, checkInitialState) {
+
+	// All up is a local minimum of a ferromagnetic chain whose
+	// fields favor all down, and a cold anneal that stays at s = 1
+	// must not leave it
+	const int n = 6;
+	std::vector<int> labels;
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < n; i++) {
+		labels.push_back(i);
+		if (i > 0) J.push_back( { i - 1, i, -1.0 });
+	}
+	IsingProblem problem(labels, std::vector<double>(n, 0.1), J);
+
+	xacc::setOption("dwave-sqa-beta", "20");
+	DWSamplerParameters params;
+	params.numReads = 10;
+	params.seed = 17;
+	params.schedule = { { 0.0, 1.0 }, { 2.0, 1.0 } };
+	params.initialState = std::vector<std::int8_t>(n, 1);
+
+	SimulatedQuantumAnnealingSampler sampler;
+	auto samples = sampler.sample(problem, params);
+	for (int i = 0; i < samples.size(); i++) {
+		EXPECT_NEAR(-5.0 + 0.6, samples.getEnergies()[i], 1e-8);
+	}
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,127 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numeric>
+#include <gtest/gtest.h>
+#include "StateVectorSampler.hpp"
+
+using namespace xacc::quantum;
+
+TEST(StateVectorSamplerTester, checkSingleQubitPrecession) {
+
+	// At fixed s, |+> precesses about the axis of
+	// H = -A/2 X + B/2 h Z, which can be done by hand
+	double h = 0.3, s = 0.25, t = 2.0, A = 6.0 * (1 - s), B = 11.0 * s;
+	IsingProblem problem(std::vector<int> { 0 }, std::vector<double> { h },
+			std::vector<IsingCoupling> { });
+
+	const double pi = 3.141592653589793;
+	auto omega = std::sqrt(A * A / 4 + B * B * h * h / 4);
+	auto nx = -A / 2 / omega, nz = B * h / 2 / omega;
+	std::complex<double> c = std::cos(2 * pi * omega * t), i(0.0, 1.0);
+	auto sn = std::sin(2 * pi * omega * t);
+	// The spin +1 amplitude of U = cos - i sin (nx X + nz Z) applied to |+>
+	auto amplitude = (c - i * sn * (nx + nz)) / std::sqrt(2.0);
+
+	xacc::setOption("dwave-sv-time-scale", "1");
+	xacc::setOption("dwave-sv-steps-per-ns", "200");
+	StateVectorSampler sampler;
+	auto probabilities = sampler.evolve(problem, { { 0.0, s }, { t, s } });
+	EXPECT_NEAR(1.0, probabilities[0] + probabilities[1], 1e-12);
+	EXPECT_NEAR(std::norm(amplitude), probabilities[1], 1e-3);
+}
+
+TEST(StateVectorSamplerTester, checkAdiabaticAnneal) {
+
+	// A slow forward anneal of a biased ferromagnetic
+	// ring ends in its ground state, all spins -1
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 6; i++) J.push_back( { i, (i + 1) % 6, -1.0 });
+	IsingProblem problem(std::vector<int> { 0, 1, 2, 3, 4, 5 },
+			std::vector<double>(6, 0.2), J);
+
+	xacc::setOption("dwave-sv-time-scale", "1");
+	xacc::setOption("dwave-sv-steps-per-ns", "50");
+	xacc::setOption("dwave-num-threads", "2");
+	DWSamplerParameters params;
+	params.numReads = 200;
+	params.seed = 41;
+	params.schedule = { { 0.0, 0.0 }, { 100.0, 1.0 } };
+
+	StateVectorSampler sampler;
+	auto probabilities = sampler.evolve(problem, params.schedule);
+	EXPECT_NEAR(1.0, std::accumulate(probabilities.begin(), probabilities.end(), 0.0), 1e-10);
+	EXPECT_GT(probabilities[0], 0.95);
+
+	auto samples = sampler.sample(problem, params);
+	EXPECT_EQ(200, samples.size());
+	int nGround = 0;
+	for (auto e : samples.getEnergies()) {
+		if (std::fabs(e + 7.2) < 1e-8) nGround++;
+	}
+	EXPECT_GT(nGround, 180);
+}
+
+TEST(StateVectorSamplerTester, checkBlockedKernel) {
+
+	// Past 12 qubits the high qubits are rotated in separate
+	// passes, which must agree with a single threaded run
+	std::vector<IsingCoupling> J;
+	std::vector<int> labels;
+	for (int i = 0; i < 14; i++) {
+		labels.push_back(i);
+		J.push_back( { i, (i + 1) % 14, (i % 3) - 1.0 });
+	}
+	IsingProblem problem(labels, std::vector<double>(14, 0.1), J);
+	AnnealSchedule schedule { { 0.0, 0.0 }, { 1.0, 0.7 } };
+
+	xacc::setOption("dwave-sv-steps-per-ns", "20");
+	xacc::setOption("dwave-num-threads", "1");
+	StateVectorSampler sampler;
+	auto serial = sampler.evolve(problem, schedule);
+	xacc::setOption("dwave-num-threads", "4");
+	auto parallel = sampler.evolve(problem, schedule);
+
+	EXPECT_NEAR(1.0, std::accumulate(parallel.begin(), parallel.end(), 0.0), 1e-10);
+	for (std::size_t x = 0; x < serial.size(); x++) {
+		EXPECT_DOUBLE_EQ(serial[x], parallel[x]);
+	}
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
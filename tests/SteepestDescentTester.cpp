@@ -0,0 +1,102 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <random>
+#include <gtest/gtest.h>
+#include "SteepestDescent.hpp"
+
+using namespace xacc::quantum;
+
+TEST(SteepestDescentTester, checkLocalMinima) {
+
+	std::mt19937 rng(101);
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::vector<int> labels;
+	std::vector<double> h;
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 80; i++) {
+		labels.push_back(i);
+		h.push_back(uniform(rng));
+		J.push_back( { i, (i + 1) % 80, uniform(rng) });
+		J.push_back( { i, (i + 11) % 80, uniform(rng) });
+	}
+	IsingProblem problem(labels, h, J, 0.5);
+
+	SampleSet samples(labels);
+	std::vector<std::int8_t> spins(80);
+	for (int s = 0; s < 100; s++) {
+		for (auto& x : spins) x = uniform(rng) > 0.0 ? 1 : -1;
+		samples.append(spins.data(), problem.energy(spins.data()), s + 1);
+	}
+
+	xacc::setOption("dwave-num-threads", "2");
+	SteepestDescent descent(problem, labels);
+	auto descended = descent.descend(samples);
+	EXPECT_EQ(100, descended.size());
+
+	for (int s = 0; s < 100; s++) {
+		descended.getSpins(s, spins.data());
+		auto energy = problem.energy(spins.data());
+		EXPECT_NEAR(energy, descended.getEnergies()[s], 1e-9);
+		EXPECT_NEAR(samples.getEnergies()[s] - energy, descent.getImprovements()[s], 1e-9);
+		EXPECT_GE(descent.getImprovements()[s], 0.0);
+		EXPECT_EQ(s + 1, descended.getNumberOfOccurrences()[s]);
+
+		// No single flip lowers the energy
+		for (int i = 0; i < 80; i++) {
+			EXPECT_GE(-2.0 * spins[i] * problem.localField(i, spins.data()), -1e-12);
+		}
+	}
+}
+
+TEST(SteepestDescentTester, checkUnmatchedColumns) {
+
+	// Column 7 is not a problem variable and must not change
+	IsingProblem problem(std::vector<int> { 3 }, std::vector<double> { 1.0 }, { });
+	SampleSet samples(std::vector<int> { 3, 7 });
+	std::vector<std::int8_t> spins { 1, 1 };
+	samples.append(spins.data(), 1.0);
+
+	SteepestDescent descent(problem, samples.getLabels());
+	auto descended = descent.descend(samples);
+	EXPECT_EQ(-1, descended.getSpin(0, 0));
+	EXPECT_EQ(1, descended.getSpin(0, 1));
+	EXPECT_EQ(-1.0, descended.getEnergies()[0]);
+	EXPECT_EQ(2.0, descent.getImprovements()[0]);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
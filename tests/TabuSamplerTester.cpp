@@ -0,0 +1,151 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <limits>
+#include <random>
+#include <gtest/gtest.h>
+#include "TabuSampler.hpp"
+
+using namespace xacc::quantum;
+
+IsingProblem randomDenseProblem(const int n, const unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> coin(0, 1);
+	std::vector<int> labels;
+	std::vector<double> h(n);
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < n; i++) {
+		labels.push_back(i);
+		h[i] = coin(rng) ? 0.5 : -0.5;
+		for (int j = i + 1; j < n; j++) {
+			J.push_back( { i, j, coin(rng) ? 1.0 : -1.0 });
+		}
+	}
+	return IsingProblem(labels, h, J);
+}
+
+double bruteForceGroundEnergy(const IsingProblem& problem) {
+	auto n = problem.size();
+	std::vector<std::int8_t> spins(n);
+	double best = std::numeric_limits<double>::infinity();
+	for (long x = 0; x < (1L << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		best = std::min(best, problem.energy(spins.data()));
+	}
+	return best;
+}
+
+TEST(TabuSamplerTester, checkDenseGroundState) {
+
+	auto problem = randomDenseProblem(14, 3);
+
+	DWSamplerParameters params;
+	params.numReads = 5;
+	params.seed = 5;
+
+	TabuSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	EXPECT_EQ(5, samples.size());
+	EXPECT_NEAR(bruteForceGroundEnergy(problem), samples.getEnergies()[0], 1e-8);
+	for (int i = 1; i < samples.size(); i++) {
+		EXPECT_LE(samples.getEnergies()[i - 1], samples.getEnergies()[i]);
+	}
+}
+
+TEST(TabuSamplerTester, checkPolish) {
+
+	auto problem = randomDenseProblem(14, 4);
+
+	// Polish a few random states
+	SampleSet initial(problem.getLabels());
+	std::mt19937 rng(9);
+	std::vector<std::int8_t> spins(problem.size());
+	for (int r = 0; r < 4; r++) {
+		for (auto& s : spins) s = (rng() & 1) ? 1 : -1;
+		initial.append(spins.data(), problem.energy(spins.data()), r + 1);
+	}
+
+	TabuSampler sampler;
+	auto polished = sampler.polish(problem, initial);
+
+	EXPECT_EQ(4, polished.size());
+	for (int r = 0; r < 4; r++) {
+		EXPECT_LE(polished.getEnergies()[r], initial.getEnergies()[r]);
+		EXPECT_EQ(r + 1, polished.getNumberOfOccurrences()[r]);
+		polished.getSpins(r, spins.data());
+		EXPECT_NEAR(problem.energy(spins.data()), polished.getEnergies()[r], 1e-8);
+	}
+
+	// The accelerator polishes through the DWSampler interface,
+	// and a restart from a given state is deterministic
+	DWSampler& service = sampler;
+	EXPECT_EQ(polished.getEnergies(), service.polish(problem, initial).getEnergies());
+}
+
+TEST(TabuSamplerTester, checkTimeout) {
+
+	auto problem = randomDenseProblem(14, 5);
+
+	xacc::setOption("dwave-tabu-timeout", "0");
+
+	DWSamplerParameters params;
+	params.numReads = 3;
+	params.seed = 6;
+
+	TabuSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	xacc::setOption("dwave-tabu-timeout", "-1");
+
+	// Restarts the time limit skipped are still local minima,
+	// not the random states they would have started from
+	EXPECT_EQ(3, samples.size());
+	std::vector<std::int8_t> spins(problem.size());
+	for (int i = 0; i < samples.size(); i++) {
+		samples.getSpins(i, spins.data());
+		auto energy = problem.energy(spins.data());
+		EXPECT_NEAR(energy, samples.getEnergies()[i], 1e-8);
+		for (int k = 0; k < problem.size(); k++) {
+			spins[k] = -spins[k];
+			EXPECT_GE(problem.energy(spins.data()), energy - 1e-8);
+			spins[k] = -spins[k];
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
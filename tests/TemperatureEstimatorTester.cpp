@@ -0,0 +1,101 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+#include "TemperatureEstimator.hpp"
+
+using namespace xacc::quantum;
+
+TEST(TemperatureEstimatorTester, checkBoltzmannSamples) {
+
+	// A random 10 spin problem, with every state weighted
+	// by its Boltzmann probability at beta = 0.7
+	const int n = 10;
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	std::vector<int> labels(n);
+	std::vector<double> h(n);
+	std::vector<IsingCoupling> couplings;
+	for (int i = 0; i < n; i++) {
+		labels[i] = 10 + i;
+		h[i] = dist(rng);
+		for (int j = i + 1; j < n; j++) {
+			if (rng() % 2) couplings.push_back({i, j, dist(rng)});
+		}
+	}
+	IsingProblem problem(labels, h, couplings);
+
+	SampleSet samples(labels);
+	std::vector<std::int8_t> spins(n);
+	double Z = 0.0;
+	for (int x = 0; x < (1 << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		Z += std::exp(-0.7 * problem.energy(spins.data()));
+	}
+	for (int x = 0; x < (1 << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		auto e = problem.energy(spins.data());
+		auto count = static_cast<int>(std::round(1e8 * std::exp(-0.7 * e) / Z));
+		if (count > 0) samples.append(spins.data(), e, count);
+	}
+
+	xacc::setOption("dwave-num-threads", "3");
+	TemperatureEstimator estimator(problem, labels);
+	EXPECT_NEAR(0.7, estimator.estimateBeta(samples), 1e-3);
+	EXPECT_LT(0, estimator.getIterations());
+
+	// Uniform samples are at infinite temperature, ground
+	// states alone at zero temperature
+	SampleSet uniform(labels), ground(labels);
+	double lowest = 1e9;
+	std::vector<std::int8_t> best(n);
+	for (int x = 0; x < (1 << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		auto e = problem.energy(spins.data());
+		uniform.append(spins.data(), e);
+		if (e < lowest) {
+			lowest = e;
+			best = spins;
+		}
+	}
+	ground.append(best.data(), lowest, 100);
+	EXPECT_NEAR(0.0, estimator.estimateBeta(uniform), 1e-9);
+	EXPECT_EQ(1e3, estimator.estimateBeta(ground));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
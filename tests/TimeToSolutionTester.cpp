@@ -0,0 +1,83 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <cmath>
+#include <gtest/gtest.h>
+#include "TimeToSolution.hpp"
+
+using namespace xacc::quantum;
+
+TEST(TimeToSolutionTester, checkTimeToSolution) {
+	EXPECT_NEAR(20.0 * std::log(0.01) / std::log(0.5), timeToSolution(0.5, 20.0), 1e-12);
+	EXPECT_EQ(20.0, timeToSolution(0.995, 20.0));
+	EXPECT_TRUE(std::isinf(timeToSolution(0.0, 20.0)));
+}
+
+TEST(TimeToSolutionTester, checkEstimate) {
+
+	// 1000 reads, 200 of which at the ground state energy -3
+	std::vector<int> labels {0, 1};
+	std::vector<std::int8_t> ground {1, -1}, excited {1, 1};
+	SampleSet samples(labels);
+	samples.append(ground.data(), -3.0, 150);
+	samples.append(excited.data(), -1.0, 800);
+	samples.append(ground.data(), -3.0, 50);
+
+	xacc::setOption("dwave-num-threads", "4");
+	auto estimate = estimateTTS(samples, -3.0, 20.0, 2000, 0.95, 7);
+	EXPECT_EQ(1000, estimate.nReads);
+	EXPECT_NEAR(0.2, estimate.successProbability, 1e-12);
+	EXPECT_NEAR(timeToSolution(0.2, 20.0), estimate.tts, 1e-12);
+
+	// The binomial interval is about 0.2 +/- 0.025
+	EXPECT_NEAR(0.175, estimate.successLower, 0.006);
+	EXPECT_NEAR(0.225, estimate.successUpper, 0.006);
+	EXPECT_NEAR(timeToSolution(estimate.successUpper, 20.0), estimate.ttsLower, 1e-12);
+	EXPECT_NEAR(timeToSolution(estimate.successLower, 20.0), estimate.ttsUpper, 1e-12);
+
+	// The same seed gives the same interval on any number of threads
+	xacc::setOption("dwave-num-threads", "1");
+	auto again = estimateTTS(samples, -3.0, 20.0, 2000, 0.95, 7);
+	EXPECT_EQ(estimate.successLower, again.successLower);
+	EXPECT_EQ(estimate.successUpper, again.successUpper);
+
+	// Nothing at the reference energy
+	auto never = estimateTTS(samples, -5.0, 20.0, 100);
+	EXPECT_EQ(0.0, never.successProbability);
+	EXPECT_TRUE(std::isinf(never.tts));
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,131 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <memory>
+#include <gtest/gtest.h>
+#include "Unembedder.hpp"
+
+using namespace xacc::quantum;
+
+// Chains spanning several words of the packed rows
+const std::map<int, std::vector<int>> embedding { { 0, { 0, 70, 130 } },
+		{ 1, { 3, 100 } }, { 2, { 5 } } };
+
+SampleSet physicalSamples(const int nCopies) {
+	std::vector<int> labels;
+	for (int q = 0; q < 140; q++) labels.push_back(q);
+	SampleSet samples(labels);
+
+	// An intact sample, (+1, -1, +1), then one with both
+	// chain 0 (+1, +1, -1) and chain 1 (+1, -1) broken
+	std::vector<std::int8_t> spins(140, -1);
+	spins[0] = spins[70] = spins[130] = spins[5] = 1;
+	samples.append(spins.data(), -3.0);
+	spins[130] = -1;
+	spins[3] = 1;
+	for (int c = 0; c < nCopies; c++) {
+		samples.append(spins.data(), -2.0);
+	}
+	return samples;
+}
+
+TEST(UnembedderTester, checkMajorityVote) {
+
+	auto physical = physicalSamples(1);
+	Unembedder unembedder(embedding, physical.getLabels());
+	auto logical = unembedder.unembed(physical, ChainBreakMethod::MajorityVote);
+
+	EXPECT_EQ((std::vector<int> { 0, 1, 2 }), logical.getLabels());
+	EXPECT_EQ(2, logical.size());
+	EXPECT_EQ(1, logical.getSpin(0, 0));
+	EXPECT_EQ(-1, logical.getSpin(0, 1));
+	EXPECT_EQ(1, logical.getSpin(0, 2));
+	EXPECT_EQ(1, logical.getSpin(1, 0));
+	EXPECT_EQ(1, logical.getSpin(1, 1));
+	EXPECT_EQ(-2.0, logical.getEnergies()[1]);
+
+	EXPECT_EQ((std::vector<double> { 0.0, 2.0 / 3.0 }),
+			unembedder.getSampleChainBreakFractions());
+	EXPECT_EQ((std::vector<double> { 0.5, 0.5, 0.0 }),
+			unembedder.getChainBreakFractions());
+}
+
+TEST(UnembedderTester, checkDiscard) {
+
+	auto physical = physicalSamples(1);
+	Unembedder unembedder(embedding, physical.getLabels());
+	auto logical = unembedder.unembed(physical, ChainBreakMethod::Discard);
+
+	EXPECT_EQ(1, logical.size());
+	EXPECT_EQ(-3.0, logical.getEnergies()[0]);
+}
+
+TEST(UnembedderTester, checkWeightedRandom) {
+
+	xacc::setOption("dwave-num-threads", "4");
+	auto physical = physicalSamples(20000);
+	Unembedder unembedder(embedding, physical.getLabels());
+	auto logical = unembedder.unembed(physical,
+			ChainBreakMethod::WeightedRandom, nullptr, 71);
+
+	double up0 = 0.0, up1 = 0.0;
+	for (int s = 1; s < logical.size(); s++) {
+		up0 += logical.getBit(s, 0) / 20000.0;
+		up1 += logical.getBit(s, 1) / 20000.0;
+	}
+	EXPECT_NEAR(2.0 / 3.0, up0, 0.015);
+	EXPECT_NEAR(0.5, up1, 0.015);
+}
+
+TEST(UnembedderTester, checkMinimizeEnergy) {
+
+	// Antiferromagnetic logical coupling between variables 0 and 1
+	IsingProblem problem(std::vector<int> { 0, 1, 2 }, std::vector<double>(3, 0.0),
+			std::vector<IsingCoupling> { { 0, 1, 1.0 } });
+
+	auto physical = physicalSamples(1);
+	Unembedder unembedder(embedding, physical.getLabels());
+	auto logical = unembedder.unembed(physical,
+			ChainBreakMethod::MinimizeEnergy, &problem);
+
+	// The majority vote (+1, +1) relaxes to (-1, +1)
+	EXPECT_EQ(-1, logical.getSpin(1, 0));
+	EXPECT_EQ(1, logical.getSpin(1, 1));
+	EXPECT_EQ(-1.0, logical.getEnergies()[1]);
+	EXPECT_EQ(-1.0, logical.getEnergies()[0]);
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
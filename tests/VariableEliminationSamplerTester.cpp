@@ -0,0 +1,111 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <gtest/gtest.h>
+#include "VariableEliminationSampler.hpp"
+
+using namespace xacc::quantum;
+
+IsingProblem randomLadder(const int length, const unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::vector<int> labels;
+	std::vector<double> h(2 * length);
+	std::vector<IsingCoupling> J;
+	for (int i = 0; i < 2 * length; i++) {
+		labels.push_back(i);
+		h[i] = uniform(rng);
+	}
+	for (int i = 0; i < length; i++) {
+		J.push_back( { 2 * i, 2 * i + 1, uniform(rng) });
+		if (i + 1 < length) {
+			J.push_back( { 2 * i, 2 * i + 2, uniform(rng) });
+			J.push_back( { 2 * i + 1, 2 * i + 3, uniform(rng) });
+		}
+	}
+	return IsingProblem(labels, h, J, 0.5);
+}
+
+TEST(VariableEliminationSamplerTester, checkEliminationWidth) {
+
+	VariableEliminationSampler sampler;
+	int width;
+
+	std::vector<IsingCoupling> chain;
+	for (int i = 0; i < 9; i++) chain.push_back( { i, i + 1, 1.0 });
+	std::vector<int> labels(10);
+	std::iota(labels.begin(), labels.end(), 0);
+	auto order = sampler.getEliminationOrder(
+			IsingProblem(labels, std::vector<double>(10, 0.0), chain), width);
+	EXPECT_EQ(1, width);
+	std::sort(order.begin(), order.end());
+	EXPECT_EQ(labels, order);
+
+	sampler.getEliminationOrder(randomLadder(10, 31), width);
+	EXPECT_EQ(2, width);
+}
+
+TEST(VariableEliminationSamplerTester, checkLowestStates) {
+
+	auto problem = randomLadder(8, 32);
+	auto n = problem.size();
+	std::vector<std::int8_t> spins(n);
+	std::vector<double> energies;
+	for (long x = 0; x < (1L << n); x++) {
+		for (int i = 0; i < n; i++) spins[i] = ((x >> i) & 1) ? 1 : -1;
+		energies.push_back(problem.energy(spins.data()));
+	}
+	std::sort(energies.begin(), energies.end());
+
+	DWSamplerParameters params;
+	params.numReads = 10;
+
+	VariableEliminationSampler sampler;
+	auto samples = sampler.sample(problem, params);
+
+	EXPECT_EQ(10, samples.size());
+	for (int i = 0; i < 10; i++) {
+		samples.getSpins(i, spins.data());
+		EXPECT_NEAR(energies[i], samples.getEnergies()[i], 1e-8);
+		EXPECT_NEAR(problem.energy(spins.data()), samples.getEnergies()[i], 1e-8);
+	}
+}
+
+int main(int argc, char** argv) {
+   xacc::Initialize(argc, argv);
+   ::testing::InitGoogleTest(&argc, argv);
+   auto ret = RUN_ALL_TESTS();
+   xacc::Finalize();
+   return ret;
+}
@@ -0,0 +1,149 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_ANNEALINGFUNCTIONS_HPP_
+#define XACC_DWAVE_UTILS_ANNEALINGFUNCTIONS_HPP_
+
+#include "DWSampler.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The AnnealingFunctions map an AnnealSchedule onto the
+ * time dependent transverse field Ising Hamiltonian
+ *
+ *    H(t) = -A(s(t))/2 sum_i X_i + B(s(t))/2 H_ising
+ *
+ * where s(t) linearly interpolates the (t, s) points of the
+ * schedule, so forward anneals, pauses and reverse anneals are
+ * all followed exactly. A(s) and B(s) are modeled as linear ramps,
+ * A(s) = A0 (1 - s) and B(s) = B0 s, with A0 and B0 in GHz (E/h)
+ * and t in microseconds.
+ */
+class AnnealingFunctions {
+
+public:
+
+	/**
+	 * The constructor, takes the anneal schedule and the
+	 * scales of the transverse and longitudinal fields.
+	 *
+	 * @param annealSchedule The (t, s) points of the anneal
+	 * @param transverseScale A(0), in GHz
+	 * @param longitudinalScale B(1), in GHz
+	 */
+	AnnealingFunctions(const AnnealSchedule& annealSchedule,
+			const double transverseScale = 6.0,
+			const double longitudinalScale = 11.0) :
+			schedule(annealSchedule), A0(transverseScale), B0(longitudinalScale) {
+		if (schedule.empty()) {
+			xacc::error("AnnealingFunctions: the anneal schedule is empty.");
+		}
+		for (std::size_t i = 0; i < schedule.size(); i++) {
+			if (schedule[i].second < 0.0 || schedule[i].second > 1.0
+					|| (i > 0 && schedule[i].first < schedule[i - 1].first)) {
+				xacc::error("AnnealingFunctions: invalid anneal schedule point ("
+						+ std::to_string(schedule[i].first) + ", "
+						+ std::to_string(schedule[i].second) + ").");
+			}
+		}
+	}
+
+	/**
+	 * Create the AnnealingFunctions for the given schedule, with
+	 * the field scales from --dwave-transverse-field-scale and
+	 * --dwave-longitudinal-field-scale, if provided.
+	 */
+	static AnnealingFunctions fromOptions(const AnnealSchedule& annealSchedule) {
+		double a0 = 6.0, b0 = 11.0;
+		if (xacc::optionExists("dwave-transverse-field-scale")) {
+			a0 = std::stod(xacc::getOption("dwave-transverse-field-scale"));
+		}
+		if (xacc::optionExists("dwave-longitudinal-field-scale")) {
+			b0 = std::stod(xacc::getOption("dwave-longitudinal-field-scale"));
+		}
+		return AnnealingFunctions(annealSchedule, a0, b0);
+	}
+
+	/**
+	 * Return the total anneal time, in microseconds.
+	 */
+	double getTotalTime() const {
+		return schedule.back().first;
+	}
+
+	/**
+	 * Return the anneal fraction s at time t, interpolating
+	 * linearly between the schedule points.
+	 *
+	 * @param t The time, in microseconds
+	 * @return s The anneal fraction
+	 */
+	double getS(const double t) const {
+		if (t <= schedule.front().first) {
+			return schedule.front().second;
+		}
+		for (std::size_t i = 1; i < schedule.size(); i++) {
+			if (t <= schedule[i].first) {
+				auto dt = schedule[i].first - schedule[i - 1].first;
+				auto frac = dt > 0.0 ? (t - schedule[i - 1].first) / dt : 1.0;
+				return schedule[i - 1].second
+						+ frac * (schedule[i].second - schedule[i - 1].second);
+			}
+		}
+		return schedule.back().second;
+	}
+
+	/**
+	 * Return the transverse field A(s), in GHz.
+	 */
+	double getTransverseField(const double s) const {
+		return A0 * (1.0 - s);
+	}
+
+	/**
+	 * Return the longitudinal field B(s), in GHz.
+	 */
+	double getLongitudinalField(const double s) const {
+		return B0 * s;
+	}
+
+protected:
+
+	AnnealSchedule schedule;
+	double A0;
+	double B0;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,149 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_DWSAMPLER_HPP_
+#define XACC_DWAVE_UTILS_DWSAMPLER_HPP_
+
+#include <random>
+#include "Identifiable.hpp"
+#include "OptionsProvider.hpp"
+#include "IsingProblem.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * An anneal schedule as a list of (t, s) points, t in
+ * microseconds and s in [0,1], as produced by the
+ * AnnealScheduleGenerator.
+ */
+using AnnealSchedule = std::vector<std::pair<double, double>>;
+
+/**
+ * The per-call parameters handed to a DWSampler.
+ */
+struct DWSamplerParameters {
+
+	/**
+	 * The number of samples to return.
+	 */
+	int numReads = 100;
+
+	/**
+	 * The anneal schedule requested by the kernel, or
+	 * the default [[0,0],[anneal-time,1]] schedule.
+	 */
+	AnnealSchedule schedule;
+
+	/**
+	 * The seed for pseudo-random samplers. Samplers
+	 * draw a random seed when this is 0.
+	 */
+	std::uint64_t seed = 0;
+
+	/**
+	 * The spin of each problem variable, in problem order, that a
+	 * reverse anneal starts from, or empty to let the sampler
+	 * choose. Samplers that cannot start from a state ignore it.
+	 */
+	std::vector<std::int8_t> initialState;
+};
+
+/**
+ * A DWSampler draws low energy samples of a finished Ising
+ * problem. The DWAccelerator handles compilation, embedding and
+ * parameter setting, and hands the resulting problem to the
+ * DWSampler named by the --dwave-sampler option, the remote
+ * D-Wave QPU by default. Local samplers are discovered as
+ * DWSampler services.
+ */
+class DWSampler : public xacc::Identifiable, public xacc::OptionsProvider {
+
+public:
+
+	/**
+	 * Sample the given Ising problem.
+	 *
+	 * @param problem The Ising problem to sample
+	 * @param params The number of reads, anneal schedule and seed
+	 * @return samples The packed samples, energies and occurrences
+	 */
+	virtual SampleSet sample(const IsingProblem& problem,
+			const DWSamplerParameters& params) = 0;
+
+	/**
+	 * Return true if this sampler starts anneals that begin
+	 * classical, reverse anneals, from params.initialState.
+	 * Other samplers start them from a random state.
+	 */
+	virtual bool supportsInitialState() const {
+		return false;
+	}
+
+	/**
+	 * Improve each of the given samples of the problem, returning
+	 * them in the same order with their occurrences. Samplers that
+	 * cannot start from given samples raise an error.
+	 *
+	 * @param problem The Ising problem
+	 * @param samples The samples to polish, over the problem's variables
+	 * @return polished The polished samples
+	 */
+	virtual SampleSet polish(const IsingProblem& problem, const SampleSet& samples) {
+		xacc::error("The " + name() + " sampler cannot polish samples.");
+		return samples;
+	}
+
+	virtual bool handleOptions(variables_map& map) {
+		return false;
+	}
+
+	virtual ~DWSampler() {}
+
+protected:
+
+	/**
+	 * Return the seed to use for the given parameters,
+	 * drawing one from std::random_device when unset.
+	 */
+	std::uint64_t getSeed(const DWSamplerParameters& params) {
+		if (params.seed != 0) {
+			return params.seed;
+		}
+		std::random_device rd;
+		return (std::uint64_t(rd()) << 32) | rd();
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,157 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_ENERGYEVALUATOR_HPP_
+#define XACC_DWAVE_UTILS_ENERGYEVALUATOR_HPP_
+
+#include <map>
+#include "IsingProblem.hpp"
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The EnergyEvaluator computes the energies of a whole SampleSet
+ * against an IsingProblem, whose variables are matched to the
+ * sample columns by label. QUBOs are evaluated through their
+ * IsingProblem::fromQUBO equivalent, which has the same energies.
+ * Problem variables missing from the samples are taken to be -1.
+ *
+ * Samples are evaluated 64 at a time, bit sliced: the block is
+ * transposed so that one word holds a variable's bit in all 64
+ * samples. A coupling then contributes J (1 - 2 (w_i ^ w_j)) to every
+ * lane, and a bias h (2 w_i - 1), which are branch free loops over
+ * the 64 lanes that the compiler vectorizes. Blocks are evaluated
+ * in parallel.
+ */
+class EnergyEvaluator {
+
+public:
+
+	/**
+	 * The constructor, takes the problem and the label
+	 * of each column of the samples to evaluate.
+	 *
+	 * @param ising The Ising problem
+	 * @param sampleLabels The variable label of each sample column
+	 */
+	EnergyEvaluator(const IsingProblem& ising,
+			const std::vector<int>& sampleLabels) :
+			problem(ising), columns(ising.size(), -1) {
+		std::map<int, int> column;
+		for (std::size_t k = 0; k < sampleLabels.size(); k++) {
+			column[sampleLabels[k]] = k;
+		}
+		for (int i = 0; i < problem.size(); i++) {
+			auto c = column.find(problem.getLabels()[i]);
+			if (c != column.end()) {
+				columns[i] = c->second;
+			}
+		}
+	}
+
+	/**
+	 * Return the energy of every sample in the given set.
+	 *
+	 * @param samples The samples, labeled as given to the constructor
+	 * @return energies The energy of each sample
+	 */
+	std::vector<double> evaluate(const SampleSet& samples) const {
+		const std::size_t R = samples.size(), n = problem.size();
+		auto& biases = problem.getBiases();
+		auto& couplings = problem.getCouplings();
+		std::vector<double> energies(R);
+
+		parallelFor((R + 63) / 64, 4, [&](std::size_t begin, std::size_t end) {
+			std::vector<std::uint64_t> slices(n);
+			double lane[64];
+			for (auto block = begin; block < end; block++) {
+				auto base = block * 64;
+				auto nLanes = std::min<std::size_t>(64, R - base);
+
+				// Transpose the block, one word per variable
+				for (std::size_t i = 0; i < n; i++) {
+					std::uint64_t w = 0;
+					if (columns[i] >= 0) {
+						auto word = columns[i] / 64, bit = columns[i] % 64;
+						for (std::size_t l = 0; l < nLanes; l++) {
+							w |= ((samples.getRow(base + l)[word] >> bit) & 1) << l;
+						}
+					}
+					slices[i] = w;
+				}
+
+				for (int l = 0; l < 64; l++) {
+					lane[l] = problem.getOffset();
+				}
+				for (std::size_t i = 0; i < n; i++) {
+					auto h = biases[i];
+					auto w = slices[i];
+					if (h == 0.0) continue;
+					for (int l = 0; l < 64; l++) {
+						lane[l] += h * (2.0 * ((w >> l) & 1) - 1.0);
+					}
+				}
+				for (auto& c : couplings) {
+					auto x = slices[c.i] ^ slices[c.j];
+					auto J = c.value;
+					for (int l = 0; l < 64; l++) {
+						lane[l] += J * (1.0 - 2.0 * ((x >> l) & 1));
+					}
+				}
+
+				std::copy(lane, lane + nLanes, &energies[base]);
+			}
+		});
+
+		return energies;
+	}
+
+	/**
+	 * Replace the energies of the given samples with
+	 * their energies against the problem.
+	 */
+	void update(SampleSet& samples) const {
+		samples.getEnergies() = evaluate(samples);
+	}
+
+protected:
+
+	IsingProblem problem;
+
+	std::vector<int> columns;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,221 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_HARDWARETILER_HPP_
+#define XACC_DWAVE_UTILS_HARDWARETILER_HPP_
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The HardwareTiler hands out disjoint regions of a hardware graph,
+ * so several small problems can be placed side by side and run as
+ * one physical problem. A region is grown breadth-first over the
+ * free qubits from the lowest free one, and only the qubits a
+ * problem ends up using are allocated, so the rest of a region is
+ * offered again to the next problem. Tiles may be adjacent, their
+ * connecting couplers are simply left unprogrammed.
+ *
+ * Samples of the combined problem are split back per tile
+ * with select, which keeps the columns of the tile's qubits.
+ */
+class HardwareTiler {
+
+public:
+
+	/**
+	 * The constructor, takes the hardware graph.
+	 *
+	 * @param nQubits The number of qubits
+	 * @param edges The couplers between qubits
+	 */
+	HardwareTiler(const int nQubits, const std::vector<std::pair<int, int>>& edges) :
+			adjacency(nQubits), used(nQubits, 0), nFree(nQubits) {
+		for (auto& e : edges) {
+			if (e.first < 0 || e.second < 0 || e.first >= nQubits
+					|| e.second >= nQubits) {
+				xacc::error("HardwareTiler: invalid coupler ("
+						+ std::to_string(e.first) + ", "
+						+ std::to_string(e.second) + ").");
+			}
+			adjacency[e.first].push_back(e.second);
+			adjacency[e.second].push_back(e.first);
+		}
+		for (auto& neighbors : adjacency) {
+			std::sort(neighbors.begin(), neighbors.end());
+		}
+	}
+
+	/**
+	 * Return up to size free qubits, in increasing order, grown
+	 * breadth-first from the lowest free qubit. A component with too
+	 * few free qubits is continued from the next lowest free qubit.
+	 */
+	std::vector<int> getRegion(const int size) const {
+		std::vector<int> region;
+		std::vector<char> seen(used);
+		std::queue<int> frontier;
+		int next = 0;
+		while (region.size() < static_cast<std::size_t>(size)) {
+			if (frontier.empty()) {
+				while (next < numberOfQubits() && seen[next]) next++;
+				if (next == numberOfQubits()) break;
+				seen[next] = 1;
+				frontier.push(next);
+			}
+			auto q = frontier.front();
+			frontier.pop();
+			region.push_back(q);
+			for (auto r : adjacency[q]) {
+				if (!seen[r]) {
+					seen[r] = 1;
+					frontier.push(r);
+				}
+			}
+		}
+		std::sort(region.begin(), region.end());
+		return region;
+	}
+
+	/**
+	 * Return the couplers between qubits of the given
+	 * region, on their indices in the region.
+	 */
+	std::vector<std::pair<int, int>> getEdges(const std::vector<int>& region) const {
+		std::map<int, int> index;
+		for (std::size_t k = 0; k < region.size(); k++) {
+			index[region[k]] = k;
+		}
+		std::vector<std::pair<int, int>> edges;
+		for (std::size_t k = 0; k < region.size(); k++) {
+			for (auto r : adjacency[region[k]]) {
+				auto it = index.find(r);
+				if (it != index.end() && static_cast<int>(k) < it->second) {
+					edges.push_back(std::make_pair(k, it->second));
+				}
+			}
+		}
+		return edges;
+	}
+
+	/**
+	 * Mark the given qubits as used by a tile.
+	 */
+	void allocate(const std::vector<int>& qubits) {
+		for (auto q : qubits) {
+			if (q < 0 || q >= numberOfQubits() || used[q]) {
+				xacc::error("HardwareTiler: qubit " + std::to_string(q)
+						+ " is not free.");
+			}
+			used[q] = 1;
+			nFree--;
+		}
+	}
+
+	/**
+	 * Free every qubit, to start tiling a new physical problem.
+	 */
+	void reset() {
+		std::fill(used.begin(), used.end(), 0);
+		nFree = numberOfQubits();
+	}
+
+	int getNumberOfFreeQubits() const {
+		return nFree;
+	}
+
+	int numberOfQubits() const {
+		return static_cast<int>(adjacency.size());
+	}
+
+	/**
+	 * Return the given samples restricted to the columns of the
+	 * given labels, in that order. Labels not sampled are left out.
+	 *
+	 * @param samples The samples of the combined problem
+	 * @param labels The labels to keep
+	 * @return samples The samples of the tile, with the same energies
+	 */
+	static SampleSet select(const SampleSet& samples, const std::vector<int>& labels) {
+		std::map<int, int> column;
+		for (int k = 0; k < samples.getNumberOfVariables(); k++) {
+			column[samples.getLabels()[k]] = k;
+		}
+		std::vector<int> kept, columns;
+		for (auto l : labels) {
+			auto it = column.find(l);
+			if (it != column.end()) {
+				kept.push_back(l);
+				columns.push_back(it->second);
+			}
+		}
+
+		const std::size_t R = samples.size();
+		const std::size_t nWords = (columns.size() + 63) / 64;
+		std::vector<std::uint64_t> rows(R * nWords, 0);
+		parallelFor(R, 256, [&](std::size_t begin, std::size_t end) {
+			for (auto s = begin; s < end; s++) {
+				auto row = samples.getRow(s);
+				auto out = rows.data() + s * nWords;
+				for (std::size_t k = 0; k < columns.size(); k++) {
+					auto c = columns[k];
+					out[k / 64] |= ((row[c / 64] >> (c % 64)) & 1) << (k % 64);
+				}
+			}
+		});
+
+		SampleSet tile(kept);
+		tile.reserve(R);
+		for (std::size_t s = 0; s < R; s++) {
+			tile.appendPacked(rows.data() + s * nWords, samples.getEnergies()[s],
+					samples.getNumberOfOccurrences()[s]);
+		}
+		return tile;
+	}
+
+protected:
+
+	std::vector<std::vector<int>> adjacency;
+
+	std::vector<char> used;
+
+	int nFree;
+};
+
+}
+}
+
+#endif
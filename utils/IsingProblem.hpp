@@ -0,0 +1,308 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_ISINGPROBLEM_HPP_
+#define XACC_DWAVE_UTILS_ISINGPROBLEM_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "XACC.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * A single J_ij term of an Ising Hamiltonian, expressed
+ * on the compact variable indices of an IsingProblem.
+ */
+struct IsingCoupling {
+	int i;
+	int j;
+	double value;
+};
+
+/**
+ * The IsingProblem is a flat, sampler friendly view of the Ising
+ * Hamiltonian
+ *
+ *    E(s) = offset + sum_i h_i s_i + sum_{i<j} J_ij s_i s_j,  s_i = +/-1
+ *
+ * Variables are stored on compact indices 0..N-1, and each one carries
+ * the label (physical qubit or logical variable) it was created for,
+ * mirroring the active_variables list returned by the remote solvers.
+ * Couplings are kept both as an i < j edge list and as a symmetric
+ * CSR adjacency, so samplers can compute local fields with a single
+ * contiguous pass over the neighbors of a variable.
+ */
+class IsingProblem {
+
+public:
+
+	IsingProblem() {}
+
+	/**
+	 * The constructor, takes the variable labels, the bias on
+	 * each variable, and the couplings between them. Duplicate
+	 * couplings are summed.
+	 *
+	 * @param variableLabels The label of each compact variable
+	 * @param h The bias on each variable
+	 * @param couplings The J_ij terms, on compact indices
+	 * @param energyOffset A constant energy offset
+	 */
+	IsingProblem(const std::vector<int>& variableLabels,
+			const std::vector<double>& h,
+			const std::vector<IsingCoupling>& couplings,
+			const double energyOffset = 0.0) :
+			labels(variableLabels), biases(h), offset(energyOffset) {
+		if (labels.size() != biases.size()) {
+			xacc::error("IsingProblem: number of labels and biases differ.");
+		}
+
+		std::map<std::pair<int, int>, double> merged;
+		for (auto& c : couplings) {
+			if (c.i == c.j || c.i < 0 || c.j < 0 || c.i >= size()
+					|| c.j >= size()) {
+				xacc::error("IsingProblem: invalid coupling ("
+						+ std::to_string(c.i) + ", " + std::to_string(c.j)
+						+ ").");
+			}
+			merged[std::make_pair(std::min(c.i, c.j), std::max(c.i, c.j))] +=
+					c.value;
+		}
+
+		for (auto& kv : merged) {
+			if (kv.second != 0.0) {
+				edges.push_back( { kv.first.first, kv.first.second, kv.second });
+			}
+		}
+
+		// Build the symmetric CSR adjacency
+		rowOffsets.assign(size() + 1, 0);
+		for (auto& e : edges) {
+			rowOffsets[e.i + 1]++;
+			rowOffsets[e.j + 1]++;
+		}
+		for (int i = 0; i < size(); i++) {
+			rowOffsets[i + 1] += rowOffsets[i];
+		}
+		neighbors.resize(rowOffsets.back());
+		couplingValues.resize(rowOffsets.back());
+		auto fill = rowOffsets;
+		for (auto& e : edges) {
+			neighbors[fill[e.i]] = e.j;
+			couplingValues[fill[e.i]++] = e.value;
+			neighbors[fill[e.j]] = e.i;
+			couplingValues[fill[e.j]++] = e.value;
+		}
+	}
+
+	/**
+	 * Create an IsingProblem from a QUBO over x_i = 0,1, using
+	 * x_i = (1 + s_i) / 2. The bit x_i = 1 maps to the spin s_i = +1,
+	 * so samples of the returned problem are samples of the QUBO.
+	 *
+	 * @param variableLabels The label of each compact variable
+	 * @param diagonal The Q_ii terms
+	 * @param offDiagonal The Q_ij terms, on compact indices
+	 * @return problem The equivalent Ising problem
+	 */
+	static IsingProblem fromQUBO(const std::vector<int>& variableLabels,
+			const std::vector<double>& diagonal,
+			const std::vector<IsingCoupling>& offDiagonal) {
+		std::vector<double> h(diagonal.size(), 0.0);
+		std::vector<IsingCoupling> J;
+		double offset = 0.0;
+		for (std::size_t i = 0; i < diagonal.size(); i++) {
+			h[i] += diagonal[i] / 2.0;
+			offset += diagonal[i] / 2.0;
+		}
+		for (auto& q : offDiagonal) {
+			J.push_back( { q.i, q.j, q.value / 4.0 });
+			h[q.i] += q.value / 4.0;
+			h[q.j] += q.value / 4.0;
+			offset += q.value / 4.0;
+		}
+		return IsingProblem(variableLabels, h, J, offset);
+	}
+
+	/**
+	 * Return the spin-reversal transform of this problem by the
+	 * given gauge, h_i g_i and J_ij g_i g_j. A state s of the
+	 * returned problem has the energy of the state g s here.
+	 *
+	 * @param gauge The +/-1 gauge of each variable
+	 * @return problem The transformed problem
+	 */
+	IsingProblem gauge(const std::vector<std::int8_t>& gauge) const {
+		if (gauge.size() != labels.size()) {
+			xacc::error("IsingProblem: the gauge does not match the problem size.");
+		}
+		std::vector<double> h(biases);
+		std::vector<IsingCoupling> J(edges);
+		for (std::size_t i = 0; i < h.size(); i++) {
+			h[i] *= gauge[i];
+		}
+		for (auto& c : J) {
+			c.value *= gauge[c.i] * gauge[c.j];
+		}
+		return IsingProblem(labels, h, J, offset);
+	}
+
+	/**
+	 * Return the number of variables in this problem.
+	 */
+	int size() const {
+		return static_cast<int>(labels.size());
+	}
+
+	const std::vector<int>& getLabels() const {
+		return labels;
+	}
+
+	const std::vector<double>& getBiases() const {
+		return biases;
+	}
+
+	/**
+	 * Return the i < j edge list of this problem.
+	 */
+	const std::vector<IsingCoupling>& getCouplings() const {
+		return edges;
+	}
+
+	double getOffset() const {
+		return offset;
+	}
+
+	/**
+	 * The CSR row offsets; the neighbors of variable i are
+	 * getNeighbors()[getRowOffsets()[i] .. getRowOffsets()[i+1]).
+	 */
+	const std::vector<int>& getRowOffsets() const {
+		return rowOffsets;
+	}
+
+	const std::vector<int>& getNeighbors() const {
+		return neighbors;
+	}
+
+	/**
+	 * The J values matching getNeighbors(), entry by entry.
+	 */
+	const std::vector<double>& getCouplingValues() const {
+		return couplingValues;
+	}
+
+	/**
+	 * Return the local field h_i + sum_j J_ij s_j seen by variable i.
+	 *
+	 * @param i The variable
+	 * @param spins The spin configuration, one +/-1 entry per variable
+	 * @return field The local field
+	 */
+	double localField(const int i, const std::int8_t* spins) const {
+		double field = biases[i];
+		for (int k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
+			field += couplingValues[k] * spins[neighbors[k]];
+		}
+		return field;
+	}
+
+	/**
+	 * Return the energy of the given spin configuration.
+	 *
+	 * @param spins The spin configuration, one +/-1 entry per variable
+	 * @return energy The energy
+	 */
+	double energy(const std::int8_t* spins) const {
+		double e = offset;
+		for (int i = 0; i < size(); i++) {
+			e += biases[i] * spins[i];
+		}
+		for (auto& c : edges) {
+			e += c.value * spins[c.i] * spins[c.j];
+		}
+		return e;
+	}
+
+	/**
+	 * Return the largest energy change a single spin flip can cause,
+	 * an upper bound used to pick hot temperatures.
+	 */
+	double maxFlipEnergy() const {
+		double maxDelta = 0.0;
+		for (int i = 0; i < size(); i++) {
+			double d = std::fabs(biases[i]);
+			for (int k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
+				d += std::fabs(couplingValues[k]);
+			}
+			maxDelta = std::max(maxDelta, 2.0 * d);
+		}
+		return maxDelta;
+	}
+
+	/**
+	 * Return the smallest non-zero energy change a single spin flip
+	 * can cause when only its smallest term changes sign, a lower
+	 * bound used to pick cold temperatures.
+	 */
+	double minFlipEnergy() const {
+		double minDelta = 0.0;
+		auto update = [&](double v) {
+			v = 2.0 * std::fabs(v);
+			if (v > 0.0 && (minDelta == 0.0 || v < minDelta)) minDelta = v;
+		};
+		for (auto& h : biases) update(h);
+		for (auto& J : couplingValues) update(J);
+		return minDelta;
+	}
+
+protected:
+
+	std::vector<int> labels;
+	std::vector<double> biases;
+	std::vector<IsingCoupling> edges;
+	double offset = 0.0;
+
+	std::vector<int> rowOffsets;
+	std::vector<int> neighbors;
+	std::vector<double> couplingValues;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,153 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_PARALLEL_HPP_
+#define XACC_DWAVE_UTILS_PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "XACC.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * Return the number of worker threads the local D-Wave
+ * components should use. This is taken from the
+ * --dwave-num-threads option, or the hardware concurrency.
+ *
+ * @return nThreads The number of threads to use
+ */
+inline int getNumberOfThreads() {
+	if (xacc::optionExists("dwave-num-threads")) {
+		return std::max(1, std::stoi(xacc::getOption("dwave-num-threads")));
+	}
+	auto n = std::thread::hardware_concurrency();
+	return n > 0 ? static_cast<int>(n) : 1;
+}
+
+/**
+ * Execute f(begin, end) over the range [0, n), split into
+ * contiguous chunks of at most grain elements. Chunks are handed
+ * out to the worker threads through a shared atomic counter, so
+ * uneven chunks are balanced automatically. The chunk boundaries
+ * only depend on n and grain, never on the number of threads, so
+ * callers may seed per-chunk state from begin deterministically.
+ *
+ * @param n The size of the range
+ * @param grain The maximum number of elements per chunk
+ * @param f The function to execute on each chunk
+ * @param nThreads The number of threads to use
+ */
+template<typename Function>
+void parallelFor(const std::size_t n, const std::size_t grain, Function f,
+		const int nThreads = getNumberOfThreads()) {
+	if (n == 0) {
+		return;
+	}
+
+	auto chunk = std::max<std::size_t>(1, grain);
+	auto nChunks = (n + chunk - 1) / chunk;
+	auto nWorkers = std::min<std::size_t>(nChunks, std::max(1, nThreads));
+
+	std::atomic<std::size_t> next(0);
+	auto worker = [&]() {
+		for (auto c = next++; c < nChunks; c = next++) {
+			auto begin = c * chunk;
+			f(begin, std::min(n, begin + chunk));
+		}
+	};
+
+	if (nWorkers == 1) {
+		worker();
+		return;
+	}
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 1; t < nWorkers; t++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& t : threads) {
+		t.join();
+	}
+}
+
+/**
+ * Replace values with its exclusive prefix sum and return the
+ * total. Blocks of the range are summed in parallel, the block
+ * sums are scanned serially, and each block is then rewritten
+ * in parallel with its block offset.
+ *
+ * @param values The values to scan in place
+ * @param nThreads The number of threads to use
+ * @return total The sum of all values
+ */
+template<typename T>
+T parallelExclusiveScan(std::vector<T>& values,
+		const int nThreads = getNumberOfThreads()) {
+	const std::size_t grain = 4096;
+	auto n = values.size();
+	auto nBlocks = (n + grain - 1) / grain;
+	std::vector<T> blockSums(nBlocks, T(0));
+
+	parallelFor(n, grain, [&](std::size_t begin, std::size_t end) {
+		T sum(0);
+		for (auto i = begin; i < end; i++) {
+			sum += values[i];
+		}
+		blockSums[begin / grain] = sum;
+	}, nThreads);
+
+	T total(0);
+	for (auto& b : blockSums) {
+		auto tmp = b;
+		b = total;
+		total += tmp;
+	}
+
+	parallelFor(n, grain, [&](std::size_t begin, std::size_t end) {
+		T sum = blockSums[begin / grain];
+		for (auto i = begin; i < end; i++) {
+			auto tmp = values[i];
+			values[i] = sum;
+			sum += tmp;
+		}
+	}, nThreads);
+
+	return total;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,133 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_SAMPLEAGGREGATION_HPP_
+#define XACC_DWAVE_UTILS_SAMPLEAGGREGATION_HPP_
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * Return a 64 bit hash of a packed sample row.
+ */
+inline std::uint64_t hashRow(const std::uint64_t* row, const std::size_t nWords) {
+	std::uint64_t h = 0x9E3779B97F4A7C15ULL ^ nWords;
+	for (std::size_t w = 0; w < nWords; w++) {
+		h ^= row[w];
+		h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+		h ^= h >> 31;
+	}
+	return h;
+}
+
+/**
+ * Return the given samples with duplicate rows merged, their
+ * occurrences summed, sorted by increasing energy. Ties keep the
+ * order in which the rows first appear.
+ *
+ * Rows are hashed in parallel and sharded by hash, and every shard
+ * is deduplicated in parallel with its own hash map, comparing the
+ * full rows of colliding hashes, so no locking is needed.
+ *
+ * @param samples The samples to aggregate
+ * @return aggregated The distinct samples
+ */
+inline SampleSet aggregate(const SampleSet& samples) {
+	const std::size_t R = samples.size(), nWords = samples.getWordsPerSample();
+	const std::size_t nShards = 64;
+
+	std::vector<std::uint64_t> hashes(R);
+	parallelFor(R, 4096, [&](std::size_t begin, std::size_t end) {
+		for (auto s = begin; s < end; s++) {
+			hashes[s] = hashRow(samples.getRow(s), nWords);
+		}
+	});
+
+	std::vector<std::vector<std::size_t>> shards(nShards);
+	for (std::size_t s = 0; s < R; s++) {
+		shards[hashes[s] % nShards].push_back(s);
+	}
+
+	// The first row of each distinct sample, and
+	// the total occurrences of its duplicates
+	std::vector<long> occurrences(R, 0);
+	std::vector<char> first(R, 0);
+	parallelFor(nShards, 1, [&](std::size_t begin, std::size_t end) {
+		for (auto shard = begin; shard < end; shard++) {
+			std::unordered_multimap<std::uint64_t, std::size_t> seen;
+			seen.reserve(shards[shard].size());
+			for (auto s : shards[shard]) {
+				auto row = samples.getRow(s);
+				auto range = seen.equal_range(hashes[s]);
+				auto match = std::find_if(range.first, range.second,
+						[&](const std::pair<const std::uint64_t, std::size_t>& kv) {
+					return std::equal(row, row + nWords, samples.getRow(kv.second));
+				});
+				if (match == range.second) {
+					seen.insert(std::make_pair(hashes[s], s));
+					first[s] = 1;
+					occurrences[s] = samples.getNumberOfOccurrences()[s];
+				} else {
+					occurrences[match->second] += samples.getNumberOfOccurrences()[s];
+				}
+			}
+		}
+	});
+
+	std::vector<std::size_t> distinct;
+	for (std::size_t s = 0; s < R; s++) {
+		if (first[s]) distinct.push_back(s);
+	}
+	auto& energies = samples.getEnergies();
+	std::stable_sort(distinct.begin(), distinct.end(),
+			[&](std::size_t a, std::size_t b) {
+		return energies[a] < energies[b];
+	});
+
+	SampleSet aggregated(samples.getLabels());
+	aggregated.reserve(distinct.size());
+	for (auto s : distinct) {
+		aggregated.appendPacked(samples.getRow(s), energies[s],
+				static_cast<int>(occurrences[s]));
+	}
+	return aggregated;
+}
+
+}
+}
+
+#endif
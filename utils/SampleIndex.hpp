@@ -0,0 +1,169 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_SAMPLEINDEX_HPP_
+#define XACC_DWAVE_UTILS_SAMPLEINDEX_HPP_
+
+#include <algorithm>
+#include <numeric>
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The SampleIndex answers ranking queries over the samples of a
+ * SampleSet: the k lowest energy samples, the k most frequent ones,
+ * and energy quantiles weighted by occurrences. It keeps its own
+ * copy of the energies and occurrences, and sample indices refer to
+ * the SampleSet it was built from.
+ *
+ * Orders are built lazily and kept. Top-k queries partially sort
+ * only as far as the largest k asked for so far, so repeated small
+ * queries cost O(k) after the first, and the first quantile query
+ * completes the energy order and its cumulative occurrences.
+ */
+class SampleIndex {
+
+public:
+
+	SampleIndex() {}
+
+	/**
+	 * The constructor, takes the samples to index.
+	 */
+	SampleIndex(const SampleSet& samples) :
+			energies(samples.getEnergies()),
+			occurrences(samples.getNumberOfOccurrences()) {
+	}
+
+	/**
+	 * Return the number of indexed samples.
+	 */
+	int size() const {
+		return static_cast<int>(energies.size());
+	}
+
+	/**
+	 * Return the indices of the k lowest energy samples, lowest
+	 * first, ties broken by sample index.
+	 */
+	std::vector<int> getLowestEnergy(const int k) {
+		auto byEnergy = [&](int a, int b) {
+			return energies[a] < energies[b] || (energies[a] == energies[b] && a < b);
+		};
+		return topK(k, energyOrder, nEnergySorted, byEnergy);
+	}
+
+	/**
+	 * Return the indices of the k most frequent samples, most
+	 * frequent first, ties broken by lower energy.
+	 */
+	std::vector<int> getMostFrequent(const int k) {
+		auto byOccurrences = [&](int a, int b) {
+			return occurrences[a] > occurrences[b]
+					|| (occurrences[a] == occurrences[b]
+							&& (energies[a] < energies[b]
+									|| (energies[a] == energies[b] && a < b)));
+		};
+		return topK(k, frequencyOrder, nFrequencySorted, byOccurrences);
+	}
+
+	/**
+	 * Return the energy below which the fraction q of the reads
+	 * fall, counting every sample as often as it occurred.
+	 *
+	 * @param q The quantile, in [0, 1]
+	 * @return energy The lowest energy with at least q of the reads at or below it
+	 */
+	double getEnergyQuantile(const double q) {
+		if (energies.empty()) {
+			xacc::error("SampleIndex: no samples to take a quantile of.");
+		}
+		if (q < 0.0 || q > 1.0) {
+			xacc::error("SampleIndex: quantile " + std::to_string(q)
+					+ " is not in [0, 1].");
+		}
+		if (cumulative.empty()) {
+			getLowestEnergy(size());
+			cumulative.resize(size());
+			long sum = 0;
+			for (int i = 0; i < size(); i++) {
+				sum += occurrences[energyOrder[i]];
+				cumulative[i] = sum;
+			}
+		}
+		auto target = q * cumulative.back();
+		auto position = std::lower_bound(cumulative.begin(), cumulative.end(),
+				target) - cumulative.begin();
+		return energies[energyOrder[std::min<long>(position, size() - 1)]];
+	}
+
+protected:
+
+	std::vector<double> energies;
+
+	std::vector<int> occurrences;
+
+	std::vector<int> energyOrder;
+
+	int nEnergySorted = 0;
+
+	std::vector<int> frequencyOrder;
+
+	int nFrequencySorted = 0;
+
+	std::vector<long> cumulative;
+
+	/**
+	 * Return the first k entries of the given order, partially
+	 * sorting it further if fewer than k entries are sorted.
+	 */
+	template<typename Compare>
+	std::vector<int> topK(const int k, std::vector<int>& order, int& nSorted,
+			Compare compare) {
+		auto count = std::max(0, std::min(k, size()));
+		if (order.empty()) {
+			order.resize(size());
+			std::iota(order.begin(), order.end(), 0);
+		}
+		if (count > nSorted) {
+			std::partial_sort(order.begin() + nSorted, order.begin() + count,
+					order.end(), compare);
+			nSorted = count;
+		}
+		return std::vector<int>(order.begin(), order.begin() + count);
+	}
+};
+
+}
+}
+
+#endif
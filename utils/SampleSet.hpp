@@ -0,0 +1,215 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_SAMPLESET_HPP_
+#define XACC_DWAVE_UTILS_SAMPLESET_HPP_
+
+#include <cstdint>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include "XACC.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The SampleSet holds the samples returned by a DWSampler as a
+ * packed bit matrix, one row per sample and one bit per variable,
+ * with the energy and number of occurrences of every row. A set bit
+ * is the spin +1 (or the QUBO value 1), matching the encoding of
+ * the solutions returned by the remote solvers.
+ *
+ * Rows are padded to a whole number of 64 bit words so that every
+ * row starts on a word boundary and can be processed independently.
+ */
+class SampleSet {
+
+public:
+
+	SampleSet() {}
+
+	/**
+	 * The constructor, takes the labels of the sampled
+	 * variables (the active variables).
+	 *
+	 * @param variableLabels The label of each sampled variable
+	 */
+	SampleSet(const std::vector<int>& variableLabels) :
+			labels(variableLabels), nWords((variableLabels.size() + 63) / 64) {
+	}
+
+	/**
+	 * Return the number of stored samples.
+	 */
+	int size() const {
+		return static_cast<int>(energies.size());
+	}
+
+	int getNumberOfVariables() const {
+		return static_cast<int>(labels.size());
+	}
+
+	const std::vector<int>& getLabels() const {
+		return labels;
+	}
+
+	/**
+	 * Return the number of 64 bit words each row occupies.
+	 */
+	std::size_t getWordsPerSample() const {
+		return nWords;
+	}
+
+	void reserve(const std::size_t nSamples) {
+		words.reserve(nSamples * nWords);
+		energies.reserve(nSamples);
+		numOccurrences.reserve(nSamples);
+	}
+
+	/**
+	 * Append a sample given as one +/-1 spin per variable.
+	 *
+	 * @param spins The spin configuration
+	 * @param energy The energy of the configuration
+	 * @param occurrences The number of times it was observed
+	 */
+	void append(const std::int8_t* spins, const double energy,
+			const int occurrences = 1) {
+		auto offset = words.size();
+		words.resize(offset + nWords, 0);
+		for (std::size_t i = 0; i < labels.size(); i++) {
+			if (spins[i] > 0) {
+				words[offset + i / 64] |= std::uint64_t(1) << (i % 64);
+			}
+		}
+		energies.push_back(energy);
+		numOccurrences.push_back(occurrences);
+	}
+
+	/**
+	 * Append a sample given as an already packed row.
+	 *
+	 * @param row The packed row, getWordsPerSample() words
+	 * @param energy The energy of the configuration
+	 * @param occurrences The number of times it was observed
+	 */
+	void appendPacked(const std::uint64_t* row, const double energy,
+			const int occurrences = 1) {
+		words.insert(words.end(), row, row + nWords);
+		energies.push_back(energy);
+		numOccurrences.push_back(occurrences);
+	}
+
+	/**
+	 * Append all samples of another SampleSet over the same variables.
+	 */
+	void append(const SampleSet& other) {
+		if (other.labels != labels) {
+			xacc::error("Cannot merge SampleSets over different variables.");
+		}
+		words.insert(words.end(), other.words.begin(), other.words.end());
+		energies.insert(energies.end(), other.energies.begin(),
+				other.energies.end());
+		numOccurrences.insert(numOccurrences.end(),
+				other.numOccurrences.begin(), other.numOccurrences.end());
+	}
+
+	/**
+	 * Return a pointer to the packed row of the given sample.
+	 */
+	const std::uint64_t* getRow(const int sample) const {
+		return words.data() + sample * nWords;
+	}
+
+	std::uint64_t* getRow(const int sample) {
+		return words.data() + sample * nWords;
+	}
+
+	bool getBit(const int sample, const int variable) const {
+		return (getRow(sample)[variable / 64] >> (variable % 64)) & 1;
+	}
+
+	int getSpin(const int sample, const int variable) const {
+		return getBit(sample, variable) ? 1 : -1;
+	}
+
+	/**
+	 * Unpack a sample into one +/-1 spin per variable.
+	 */
+	void getSpins(const int sample, std::int8_t* spins) const {
+		auto row = getRow(sample);
+		for (std::size_t i = 0; i < labels.size(); i++) {
+			spins[i] = ((row[i / 64] >> (i % 64)) & 1) ? 1 : -1;
+		}
+	}
+
+	/**
+	 * Return the sample as a bitset in the layout used by
+	 * the AQCAcceleratorBuffer measurements, where the first
+	 * variable is the most significant bit.
+	 */
+	boost::dynamic_bitset<> getBitset(const int sample) const {
+		auto n = labels.size();
+		boost::dynamic_bitset<> bset(n);
+		for (std::size_t i = 0; i < n; i++) {
+			bset[n - 1 - i] = getBit(sample, i);
+		}
+		return bset;
+	}
+
+	std::vector<double>& getEnergies() {
+		return energies;
+	}
+
+	const std::vector<double>& getEnergies() const {
+		return energies;
+	}
+
+	std::vector<int>& getNumberOfOccurrences() {
+		return numOccurrences;
+	}
+
+	const std::vector<int>& getNumberOfOccurrences() const {
+		return numOccurrences;
+	}
+
+protected:
+
+	std::vector<int> labels;
+	std::size_t nWords = 0;
+	std::vector<std::uint64_t> words;
+	std::vector<double> energies;
+	std::vector<int> numOccurrences;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,235 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_SAMPLESTATISTICS_HPP_
+#define XACC_DWAVE_UTILS_SAMPLESTATISTICS_HPP_
+
+#include <map>
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The SampleStatistics estimates the magnetizations <s_i> and the
+ * spin correlations <s_i s_j> of a SampleSet, every sample weighted
+ * by its number of occurrences.
+ *
+ * Samples are streamed 64 at a time and bit sliced as in the
+ * EnergyEvaluator, so memory stays at one word per variable whatever
+ * the number of samples. With the occurrences of the block in 64
+ * lanes, a spin sums to 2 sum_l w_l b_l - W and a product of spins to
+ * W - 2 sum_l w_l (b_i ^ b_j)_l, branch free loops over the lanes that
+ * the compiler vectorizes. The outputs are split into chunks computed
+ * in parallel, each chunk streaming the samples for its own variables,
+ * so results do not depend on the number of threads.
+ *
+ * The SampleSet must outlive the SampleStatistics.
+ */
+class SampleStatistics {
+
+public:
+
+	/**
+	 * The constructor, takes the samples to estimate over.
+	 */
+	SampleStatistics(const SampleSet& sampleSet) :
+			samples(sampleSet), totalWeight(0.0) {
+		for (auto o : samples.getNumberOfOccurrences()) {
+			totalWeight += o;
+		}
+		for (int k = 0; k < samples.getNumberOfVariables(); k++) {
+			columns[samples.getLabels()[k]] = k;
+		}
+	}
+
+	/**
+	 * Return the magnetization <s_i> of each variable,
+	 * in the label order of the samples.
+	 */
+	std::vector<double> getMagnetizations() const {
+		checkWeight();
+		const std::size_t n = samples.getNumberOfVariables();
+		std::vector<double> magnetizations(n);
+		parallelFor(n, 64, [&](std::size_t begin, std::size_t end) {
+			std::vector<int> chunkColumns;
+			for (auto i = begin; i < end; i++) {
+				chunkColumns.push_back(i);
+			}
+			std::vector<double> ones(end - begin, 0.0);
+			stream(chunkColumns, [&](const std::uint64_t* slices, const double* weights) {
+				for (std::size_t k = 0; k < ones.size(); k++) {
+					ones[k] += laneSum(slices[k], weights);
+				}
+			});
+			for (auto i = begin; i < end; i++) {
+				magnetizations[i] = 2.0 * ones[i - begin] / totalWeight - 1.0;
+			}
+		});
+		return magnetizations;
+	}
+
+	/**
+	 * Return the correlation <s_i s_j> of each of the given pairs of
+	 * variable labels, for instance the couplings of a problem.
+	 *
+	 * @param edges The variable label pairs
+	 * @return correlations The correlation of each pair
+	 */
+	std::vector<double> getCorrelations(
+			const std::vector<std::pair<int, int>>& edges) const {
+		checkWeight();
+		std::vector<int> edgeColumns;
+		for (auto& e : edges) {
+			edgeColumns.push_back(getColumn(e.first));
+			edgeColumns.push_back(getColumn(e.second));
+		}
+
+		std::vector<double> correlations(edges.size());
+		parallelFor(edges.size(), 256, [&](std::size_t begin, std::size_t end) {
+			std::vector<int> chunkColumns(edgeColumns.begin() + 2 * begin,
+					edgeColumns.begin() + 2 * end);
+			std::vector<double> differ(end - begin, 0.0);
+			stream(chunkColumns, [&](const std::uint64_t* slices, const double* weights) {
+				for (std::size_t k = 0; k < differ.size(); k++) {
+					differ[k] += laneSum(slices[2 * k] ^ slices[2 * k + 1], weights);
+				}
+			});
+			for (auto e = begin; e < end; e++) {
+				correlations[e] = 1.0 - 2.0 * differ[e - begin] / totalWeight;
+			}
+		});
+		return correlations;
+	}
+
+	/**
+	 * Return the full correlation matrix <s_i s_j>, row major
+	 * over the label order of the samples.
+	 */
+	std::vector<double> getCorrelationMatrix() const {
+		checkWeight();
+		const std::size_t n = samples.getNumberOfVariables();
+		std::vector<double> matrix(n * n, 1.0);
+
+		// A chunk of rows needs the upper triangle from its
+		// first row on, the rest is filled in by symmetry
+		parallelFor(n, 16, [&](std::size_t begin, std::size_t end) {
+			std::vector<int> chunkColumns;
+			for (auto j = begin; j < n; j++) {
+				chunkColumns.push_back(j);
+			}
+			std::vector<double> differ((end - begin) * n, 0.0);
+			stream(chunkColumns, [&](const std::uint64_t* slices, const double* weights) {
+				for (auto i = begin; i < end; i++) {
+					auto si = slices[i - begin];
+					auto row = &differ[(i - begin) * n];
+					for (auto j = i + 1; j < n; j++) {
+						row[j] += laneSum(si ^ slices[j - begin], weights);
+					}
+				}
+			});
+			for (auto i = begin; i < end; i++) {
+				for (auto j = i + 1; j < n; j++) {
+					auto c = 1.0 - 2.0 * differ[(i - begin) * n + j] / totalWeight;
+					matrix[i * n + j] = c;
+					matrix[j * n + i] = c;
+				}
+			}
+		});
+		return matrix;
+	}
+
+protected:
+
+	const SampleSet& samples;
+
+	double totalWeight;
+
+	std::map<int, int> columns;
+
+	int getColumn(const int label) const {
+		auto c = columns.find(label);
+		if (c == columns.end()) {
+			xacc::error("SampleStatistics: variable " + std::to_string(label)
+					+ " is not in the samples.");
+		}
+		return c->second;
+	}
+
+	void checkWeight() const {
+		if (totalWeight <= 0.0) {
+			xacc::error("SampleStatistics: there are no samples to estimate over.");
+		}
+	}
+
+	/**
+	 * Return the sum of the weights of the lanes set in the given word.
+	 */
+	static double laneSum(const std::uint64_t word, const double* weights) {
+		double sum = 0.0;
+		for (int l = 0; l < 64; l++) {
+			sum += weights[l] * ((word >> l) & 1);
+		}
+		return sum;
+	}
+
+	/**
+	 * Call f(slices, weights) on each block of 64 samples, where
+	 * slices[k] holds the bits of the given k-th column in the block
+	 * and weights the occurrences of its samples, 0 past the end.
+	 */
+	template<typename Function>
+	void stream(const std::vector<int>& blockColumns, Function f) const {
+		const std::size_t R = samples.size();
+		std::vector<std::uint64_t> slices(blockColumns.size());
+		double weights[64];
+		for (std::size_t base = 0; base < R; base += 64) {
+			auto nLanes = std::min<std::size_t>(64, R - base);
+			for (std::size_t l = 0; l < 64; l++) {
+				weights[l] = l < nLanes ? samples.getNumberOfOccurrences()[base + l] : 0.0;
+			}
+			for (std::size_t k = 0; k < blockColumns.size(); k++) {
+				auto word = blockColumns[k] / 64, bit = blockColumns[k] % 64;
+				std::uint64_t w = 0;
+				for (std::size_t l = 0; l < nLanes; l++) {
+					w |= ((samples.getRow(base + l)[word] >> bit) & 1) << l;
+				}
+				slices[k] = w;
+			}
+			f(slices.data(), weights);
+		}
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,176 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_SAMPLINGMONITOR_HPP_
+#define XACC_DWAVE_UTILS_SAMPLINGMONITOR_HPP_
+
+#include <cmath>
+#include <limits>
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The SamplingMonitor keeps running statistics of the chunks of
+ * reads of an adaptive run, the lowest energy, how often it was
+ * read and the mean energy with its variance, and decides when the
+ * run has sampled enough. It is converged once any of
+ *
+ *  - the lowest energy did not change in the last chunk, and a
+ *    chunk of reads would have found a state as frequent as it with
+ *    the given confidence, 1 - (1 - p)^chunk, so lower states that
+ *    remain unseen are rarer than that,
+ *  - the standard error of the mean energy is within the tolerance,
+ *  - the read budget is spent
+ *
+ * holds. Each criterion is off when its target is not positive.
+ */
+class SamplingMonitor {
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param budget The largest number of reads
+	 * @param targetConfidence The confidence of having seen the lowest energy
+	 * @param targetTolerance The standard error of the mean energy
+	 */
+	SamplingMonitor(const long budget, const double targetConfidence = 0.99,
+			const double targetTolerance = 0.0) :
+			maxReads(budget), confidence(targetConfidence),
+			tolerance(targetTolerance) {
+	}
+
+	/**
+	 * Add a chunk of reads to the statistics.
+	 */
+	void update(const SampleSet& chunk) {
+		long chunkReads = 0;
+		auto previousBest = bestEnergy;
+		for (int i = 0; i < chunk.size(); i++) {
+			auto e = chunk.getEnergies()[i];
+			auto w = chunk.getNumberOfOccurrences()[i];
+			auto epsilon = 1e-9 * std::max(1.0, std::fabs(e));
+			if (nReads == 0 || e < bestEnergy - epsilon) {
+				bestEnergy = e;
+				bestCount = 0;
+			}
+			if (std::fabs(e - bestEnergy) <= epsilon) {
+				bestCount += w;
+			}
+
+			// Weighted Welford update of the mean and variance
+			nReads += w;
+			auto delta = e - mean;
+			mean += w * delta / nReads;
+			m2 += w * delta * (e - mean);
+			chunkReads += w;
+		}
+		lastChunkReads = chunkReads;
+		improved = bestEnergy < previousBest;
+		nChunks++;
+	}
+
+	/**
+	 * Return true once the run has sampled enough.
+	 */
+	bool isConverged() const {
+		if (nReads >= maxReads) {
+			return true;
+		}
+		if (nChunks > 1 && !improved && confidence > 0.0
+				&& 1.0 - std::pow(1.0 - getGroundStateFrequency(), lastChunkReads)
+						>= confidence) {
+			return true;
+		}
+		return tolerance > 0.0 && nReads > 1 && getStandardError() <= tolerance;
+	}
+
+	double getBestEnergy() const {
+		return bestEnergy;
+	}
+
+	/**
+	 * Return the fraction of reads at the lowest energy.
+	 */
+	double getGroundStateFrequency() const {
+		return nReads > 0 ? double(bestCount) / nReads : 0.0;
+	}
+
+	double getMeanEnergy() const {
+		return mean;
+	}
+
+	/**
+	 * Return the standard error of the mean energy.
+	 */
+	double getStandardError() const {
+		return nReads > 1 ? std::sqrt(m2 / (nReads - 1) / nReads) : 0.0;
+	}
+
+	long getNumberOfReads() const {
+		return nReads;
+	}
+
+	int getNumberOfChunks() const {
+		return nChunks;
+	}
+
+protected:
+
+	long maxReads;
+
+	double confidence;
+
+	double tolerance;
+
+	double bestEnergy = std::numeric_limits<double>::infinity();
+
+	long bestCount = 0;
+
+	long nReads = 0;
+
+	double mean = 0.0;
+
+	double m2 = 0.0;
+
+	long lastChunkReads = 0;
+
+	bool improved = false;
+
+	int nChunks = 0;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_SPLITMIX64_HPP_
+#define XACC_DWAVE_UTILS_SPLITMIX64_HPP_
+
+#include <cstdint>
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * SplitMix64 is a tiny pseudo-random generator with 8 bytes of
+ * state, used where samplers keep one generator per replica or
+ * per Trotter slice so updates can run in any thread order.
+ */
+class SplitMix64 {
+
+public:
+
+	SplitMix64(const std::uint64_t seed = 0) : state(seed) {}
+
+	/**
+	 * Create a generator for the given stream of a seed, so
+	 * that the streams of different indices are uncorrelated.
+	 */
+	SplitMix64(const std::uint64_t seed, const std::uint64_t stream) :
+			state(seed) {
+		state ^= SplitMix64(stream ^ 0x632BE59BD9B4E019ULL).next();
+	}
+
+	/**
+	 * Return the next 64 random bits.
+	 */
+	std::uint64_t next() {
+		std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * Return a uniform double in [0, 1).
+	 */
+	double uniform() {
+		return (next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+protected:
+
+	std::uint64_t state;
+};
+
+}
+}
+
+#endif
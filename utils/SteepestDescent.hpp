@@ -0,0 +1,168 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_STEEPESTDESCENT_HPP_
+#define XACC_DWAVE_UTILS_STEEPESTDESCENT_HPP_
+
+#include <map>
+#include "IsingProblem.hpp"
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * SteepestDescent post-processes samples into local minima of an
+ * IsingProblem, whose variables are matched to the sample columns
+ * by label. Each sample repeatedly flips the spin that lowers the
+ * energy most until no single flip does. Local fields and flip
+ * energies are kept in arrays updated incrementally over the
+ * flipped spin's neighbors, so a flip costs its degree plus the
+ * scan for the best flip. Samples are processed in parallel.
+ *
+ * Problem variables missing from the samples stay at -1, and
+ * sample columns that are not problem variables are left alone.
+ */
+class SteepestDescent {
+
+public:
+
+	/**
+	 * The constructor, takes the problem and the label
+	 * of each column of the samples to descend.
+	 *
+	 * @param ising The Ising problem
+	 * @param sampleLabels The variable label of each sample column
+	 */
+	SteepestDescent(const IsingProblem& ising,
+			const std::vector<int>& sampleLabels) :
+			problem(ising), columns(ising.size(), -1) {
+		std::map<int, int> column;
+		for (std::size_t k = 0; k < sampleLabels.size(); k++) {
+			column[sampleLabels[k]] = k;
+		}
+		for (int i = 0; i < problem.size(); i++) {
+			auto c = column.find(problem.getLabels()[i]);
+			if (c != column.end()) {
+				columns[i] = c->second;
+			}
+		}
+	}
+
+	/**
+	 * Return the given samples, each descended to a local
+	 * minimum, with their new energies. Samples keep their order
+	 * and occurrences.
+	 *
+	 * @param samples The samples to improve
+	 * @return descended The improved samples
+	 */
+	SampleSet descend(const SampleSet& samples) {
+		const std::size_t R = samples.size(), n = problem.size();
+		const std::size_t nWords = samples.getWordsPerSample();
+		auto& rowOffsets = problem.getRowOffsets();
+		auto& neighbors = problem.getNeighbors();
+		auto& couplingValues = problem.getCouplingValues();
+
+		std::vector<std::uint64_t> rows(R * nWords);
+		std::vector<double> energies(R);
+		improvements.assign(R, 0.0);
+
+		parallelFor(R, 64, [&](std::size_t begin, std::size_t end) {
+			std::vector<std::int8_t> spins(n);
+			std::vector<double> fields(n), deltas(n);
+			for (auto s = begin; s < end; s++) {
+				auto out = &rows[s * nWords];
+				std::copy(samples.getRow(s), samples.getRow(s) + nWords, out);
+				for (std::size_t i = 0; i < n; i++) {
+					spins[i] = columns[i] >= 0
+							&& ((out[columns[i] / 64] >> (columns[i] % 64)) & 1) ? 1 : -1;
+				}
+				for (std::size_t i = 0; i < n; i++) {
+					fields[i] = problem.localField(i, spins.data());
+					deltas[i] = columns[i] >= 0 ? -2.0 * spins[i] * fields[i] : 0.0;
+				}
+
+				auto energy = problem.energy(spins.data());
+				auto initial = energy;
+				while (true) {
+					auto best = std::min_element(deltas.begin(), deltas.end())
+							- deltas.begin();
+					if (n == 0 || deltas[best] >= 0.0) break;
+
+					energy += deltas[best];
+					spins[best] = -spins[best];
+					deltas[best] = -deltas[best];
+					out[columns[best] / 64] ^= std::uint64_t(1) << (columns[best] % 64);
+					for (int k = rowOffsets[best]; k < rowOffsets[best + 1]; k++) {
+						auto j = neighbors[k];
+						fields[j] += 2.0 * couplingValues[k] * spins[best];
+						if (columns[j] >= 0) {
+							deltas[j] = -2.0 * spins[j] * fields[j];
+						}
+					}
+				}
+
+				energies[s] = energy;
+				improvements[s] = initial - energy;
+			}
+		});
+
+		SampleSet descended(samples.getLabels());
+		descended.reserve(R);
+		for (std::size_t s = 0; s < R; s++) {
+			descended.appendPacked(&rows[s * nWords], energies[s],
+					samples.getNumberOfOccurrences()[s]);
+		}
+		return descended;
+	}
+
+	/**
+	 * Return the energy each sample of the last
+	 * descend call was lowered by.
+	 */
+	const std::vector<double>& getImprovements() const {
+		return improvements;
+	}
+
+protected:
+
+	IsingProblem problem;
+
+	std::vector<int> columns;
+
+	std::vector<double> improvements;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,197 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_TEMPERATUREESTIMATOR_HPP_
+#define XACC_DWAVE_UTILS_TEMPERATUREESTIMATOR_HPP_
+
+#include <cmath>
+#include <map>
+#include "IsingProblem.hpp"
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The TemperatureEstimator fits the effective inverse temperature
+ * beta of a Boltzmann distribution exp(-beta E(s)) to a SampleSet,
+ * by maximum pseudo-likelihood. With f_i the local field of s_i,
+ * each spin given the others is +/-1 with probability
+ * exp(-beta s_i f_i) / 2 cosh(beta f_i), so the log pseudo-likelihood
+ *
+ *    L(beta) = sum_s w_s sum_i -beta s_i f_i - ln 2 cosh(beta f_i)
+ *
+ * is concave in beta, with gradient sum -s_i f_i - f_i tanh(beta f_i)
+ * and curvature -sum f_i^2 sech^2(beta f_i). Its maximum is found by
+ * Newton iteration safeguarded by bisection in [0, maxBeta]. Samples
+ * lower in energy than uniformly random ones give a positive beta,
+ * samples at local minima only give maxBeta.
+ *
+ * Problem variables are matched to the sample columns by label, and
+ * those missing from the samples are taken to be -1 and are not
+ * fitted. The gradient and curvature are summed over chunks of
+ * samples in parallel and reduced in chunk order, so the result
+ * does not depend on the number of threads.
+ */
+class TemperatureEstimator {
+
+public:
+
+	/**
+	 * The constructor, takes the problem and the label
+	 * of each column of the samples to fit.
+	 *
+	 * @param ising The Ising problem
+	 * @param sampleLabels The variable label of each sample column
+	 * @param betaMax The largest inverse temperature returned
+	 */
+	TemperatureEstimator(const IsingProblem& ising,
+			const std::vector<int>& sampleLabels, const double betaMax = 1e3) :
+			problem(ising), columns(ising.size(), -1), maxBeta(betaMax) {
+		std::map<int, int> column;
+		for (std::size_t k = 0; k < sampleLabels.size(); k++) {
+			column[sampleLabels[k]] = k;
+		}
+		for (int i = 0; i < problem.size(); i++) {
+			auto c = column.find(problem.getLabels()[i]);
+			if (c != column.end()) {
+				columns[i] = c->second;
+			}
+		}
+	}
+
+	/**
+	 * Return the inverse temperature, in inverse units of the
+	 * problem energy, that maximizes the pseudo-likelihood
+	 * of the given samples.
+	 */
+	double estimateBeta(const SampleSet& samples) {
+		iterations = 0;
+		double gradient, curvature;
+		derivatives(samples, 0.0, gradient, curvature);
+		if (gradient <= 0.0) {
+			return 0.0;
+		}
+		derivatives(samples, maxBeta, gradient, curvature);
+		if (gradient >= 0.0) {
+			return maxBeta;
+		}
+
+		double lo = 0.0, hi = maxBeta, beta = std::min(1.0, maxBeta / 2.0);
+		for (iterations = 1; iterations <= 100; iterations++) {
+			derivatives(samples, beta, gradient, curvature);
+			if (gradient > 0.0) {
+				lo = beta;
+			} else {
+				hi = beta;
+			}
+			auto next = curvature < 0.0 ? beta - gradient / curvature : -1.0;
+			if (!(next > lo && next < hi)) {
+				next = 0.5 * (lo + hi);
+			}
+			auto step = std::fabs(next - beta);
+			beta = next;
+			if (step <= 1e-12 * std::max(1.0, beta)) {
+				break;
+			}
+		}
+		return beta;
+	}
+
+	/**
+	 * Return the number of Newton iterations of the last estimate.
+	 */
+	int getIterations() const {
+		return iterations;
+	}
+
+protected:
+
+	IsingProblem problem;
+
+	std::vector<int> columns;
+
+	double maxBeta;
+
+	int iterations = 0;
+
+	/**
+	 * Compute the gradient and curvature of the log
+	 * pseudo-likelihood at beta, per read and variable.
+	 */
+	void derivatives(const SampleSet& samples, const double beta,
+			double& gradient, double& curvature) const {
+		const std::size_t R = samples.size(), n = problem.size(), grain = 256;
+		auto& occurrences = samples.getNumberOfOccurrences();
+		std::vector<double> gradients((R + grain - 1) / grain, 0.0);
+		std::vector<double> curvatures(gradients.size(), 0.0), weights(gradients.size(), 0.0);
+
+		parallelFor(R, grain, [&](std::size_t begin, std::size_t end) {
+			std::vector<std::int8_t> spins(n);
+			double g = 0.0, c = 0.0, w = 0.0;
+			for (auto s = begin; s < end; s++) {
+				for (std::size_t i = 0; i < n; i++) {
+					spins[i] = columns[i] >= 0 ? samples.getSpin(s, columns[i]) : -1;
+				}
+				double gs = 0.0, cs = 0.0;
+				for (std::size_t i = 0; i < n; i++) {
+					if (columns[i] < 0) continue;
+					auto f = problem.localField(i, spins.data());
+					auto t = std::tanh(beta * f);
+					gs -= spins[i] * f + f * t;
+					cs -= f * f * (1.0 - t * t);
+				}
+				g += occurrences[s] * gs;
+				c += occurrences[s] * cs;
+				w += occurrences[s];
+			}
+			gradients[begin / grain] = g;
+			curvatures[begin / grain] = c;
+			weights[begin / grain] = w;
+		});
+
+		double totalWeight = 0.0;
+		gradient = curvature = 0.0;
+		for (std::size_t k = 0; k < gradients.size(); k++) {
+			gradient += gradients[k];
+			curvature += curvatures[k];
+			totalWeight += weights[k];
+		}
+		auto scale = std::max(1.0, totalWeight * n);
+		gradient /= scale;
+		curvature /= scale;
+	}
+};
+
+}
+}
+
+#endif
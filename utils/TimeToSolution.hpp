@@ -0,0 +1,142 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_TIMETOSOLUTION_HPP_
+#define XACC_DWAVE_UTILS_TIMETOSOLUTION_HPP_
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The time to solution of a set of reads, with the
+ * bootstrapped confidence interval of both estimates.
+ */
+struct TTSEstimate {
+	long nReads = 0;
+	double successProbability = 0.0;
+	double successLower = 0.0;
+	double successUpper = 0.0;
+	double tts = 0.0;
+	double ttsLower = 0.0;
+	double ttsUpper = 0.0;
+};
+
+/**
+ * Return the time needed to find the ground state at least once
+ * with the given confidence, repeating runs of the given time that
+ * each succeed with probability p,
+ *
+ *    TTS = t ln(1 - confidence) / ln(1 - p),
+ *
+ * and t if a single run suffices. This is infinite for p = 0.
+ */
+inline double timeToSolution(const double p, const double runTime,
+		const double confidence = 0.99) {
+	if (p <= 0.0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	if (p >= confidence) {
+		return runTime;
+	}
+	return runTime * std::log(1.0 - confidence) / std::log(1.0 - p);
+}
+
+/**
+ * Estimate the TTS of the given samples, counting a read as
+ * successful if its energy is within tolerance of the reference
+ * energy, exact or best known. The confidence interval comes from
+ * a parametric bootstrap: every replicate redraws the number of
+ * successes of the same number of reads, replicates are drawn in
+ * parallel each from its own seeded stream, and the percentiles of
+ * the success probabilities give the interval, mapped to TTS.
+ *
+ * @param samples The samples of a run
+ * @param referenceEnergy The ground state energy
+ * @param runTime The time of one read, the anneal time
+ * @param nBootstrap The number of bootstrap replicates
+ * @param level The level of the confidence interval
+ * @param seed The bootstrap seed
+ * @param tolerance The energy tolerance of a success
+ * @return estimate The TTS estimate
+ */
+inline TTSEstimate estimateTTS(const SampleSet& samples,
+		const double referenceEnergy, const double runTime,
+		const int nBootstrap = 1000, const double level = 0.95,
+		const std::uint64_t seed = 0, const double tolerance = 1e-6) {
+
+	TTSEstimate estimate;
+	long successes = 0;
+	for (int i = 0; i < samples.size(); i++) {
+		estimate.nReads += samples.getNumberOfOccurrences()[i];
+		if (samples.getEnergies()[i] <= referenceEnergy + tolerance) {
+			successes += samples.getNumberOfOccurrences()[i];
+		}
+	}
+	if (estimate.nReads == 0) {
+		xacc::error("estimateTTS: there are no reads.");
+	}
+
+	auto p = double(successes) / estimate.nReads;
+	estimate.successProbability = p;
+	estimate.successLower = estimate.successUpper = p;
+
+	if (nBootstrap > 0) {
+		std::vector<double> replicates(nBootstrap);
+		parallelFor(nBootstrap, 64, [&](std::size_t begin, std::size_t end) {
+			for (auto b = begin; b < end; b++) {
+				std::mt19937_64 rng(SplitMix64(seed, b).next());
+				std::binomial_distribution<long> draw(estimate.nReads, p);
+				replicates[b] = double(draw(rng)) / estimate.nReads;
+			}
+		});
+		std::sort(replicates.begin(), replicates.end());
+		auto tail = 0.5 * (1.0 - level) * (nBootstrap - 1);
+		estimate.successLower = replicates[static_cast<int>(std::floor(tail))];
+		estimate.successUpper = replicates[static_cast<int>(std::ceil(
+				nBootstrap - 1 - tail))];
+	}
+
+	estimate.tts = timeToSolution(p, runTime);
+	estimate.ttsLower = timeToSolution(estimate.successUpper, runTime);
+	estimate.ttsUpper = timeToSolution(estimate.successLower, runTime);
+	return estimate;
+}
+
+}
+}
+
+#endif
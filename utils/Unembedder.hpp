@@ -0,0 +1,308 @@
+/***********************************************************************************
+ * Copyright (c) 2017, UT-Battelle
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the xacc nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contributors:
+ *   Initial API and implementation - Alex McCaskey
+ *
+ **********************************************************************************/
+#ifndef XACC_DWAVE_UTILS_UNEMBEDDER_HPP_
+#define XACC_DWAVE_UTILS_UNEMBEDDER_HPP_
+
+#include <map>
+#include "EnergyEvaluator.hpp"
+#include "Parallel.hpp"
+#include "SampleSet.hpp"
+#include "SplitMix64.hpp"
+
+namespace xacc {
+namespace quantum {
+
+/**
+ * The ways a broken chain, one whose physical qubits
+ * disagree, is resolved to a logical value.
+ */
+enum class ChainBreakMethod {
+	MajorityVote, Discard, WeightedRandom, MinimizeEnergy
+};
+
+/**
+ * Return the ChainBreakMethod with the given name, one of
+ * majority-vote, discard, weighted-random or minimize-energy.
+ */
+inline ChainBreakMethod getChainBreakMethod(const std::string& name) {
+	if (name == "majority-vote") {
+		return ChainBreakMethod::MajorityVote;
+	} else if (name == "discard") {
+		return ChainBreakMethod::Discard;
+	} else if (name == "weighted-random") {
+		return ChainBreakMethod::WeightedRandom;
+	} else if (name == "minimize-energy") {
+		return ChainBreakMethod::MinimizeEnergy;
+	}
+	xacc::error("Invalid chain break method " + name + ", must be majority-vote, "
+			"discard, weighted-random or minimize-energy.");
+	return ChainBreakMethod::MajorityVote;
+}
+
+/**
+ * The Unembedder maps samples over physical qubits back to the
+ * logical variables of an Embedding. Each chain is stored as the
+ * word masks of its qubits in a packed physical row, so the number
+ * of its qubits at +1 in a sample is a few popcounts. Unbroken chains
+ * take the common value of their qubits, broken ones are resolved by
+ * the requested ChainBreakMethod:
+ *
+ *  - MajorityVote takes the majority value, +1 on ties,
+ *  - Discard drops every sample with a broken chain,
+ *  - WeightedRandom picks +1 with the fraction of qubits at +1,
+ *  - MinimizeEnergy starts from the majority vote and greedily
+ *    aligns broken chains with their logical local field until
+ *    no single broken chain flip lowers the logical energy.
+ *
+ * Samples are unembedded in parallel. The fraction of broken
+ * chains of every physical sample, and the fraction of reads in
+ * which every chain is broken, are kept for reporting.
+ */
+class Unembedder {
+
+public:
+
+	/**
+	 * The constructor, takes the embedding of the logical variables
+	 * and the physical qubit of each column of the samples. Logical
+	 * variables with no sampled qubit are left out.
+	 *
+	 * @param embedding The physical qubits of each logical variable
+	 * @param physicalLabels The qubit of each sampled column
+	 */
+	Unembedder(const std::map<int, std::vector<int>>& embedding,
+			const std::vector<int>& physicalLabels) {
+		std::map<int, int> column;
+		for (std::size_t k = 0; k < physicalLabels.size(); k++) {
+			column[physicalLabels[k]] = k;
+		}
+
+		for (auto& kv : embedding) {
+			std::map<std::size_t, std::uint64_t> masks;
+			int length = 0;
+			for (auto q : kv.second) {
+				auto c = column.find(q);
+				if (c != column.end()) {
+					masks[c->second / 64] |= std::uint64_t(1) << (c->second % 64);
+					length++;
+				}
+			}
+			if (length == 0) {
+				continue;
+			}
+
+			Chain chain;
+			chain.length = length;
+			for (auto& m : masks) {
+				chain.words.push_back(m.first);
+				chain.masks.push_back(m.second);
+			}
+			labels.push_back(kv.first);
+			chains.push_back(chain);
+		}
+	}
+
+	/**
+	 * Return the logical variables samples are unembedded to.
+	 */
+	const std::vector<int>& getLabels() const {
+		return labels;
+	}
+
+	/**
+	 * Unembed the given physical samples. Energies are evaluated
+	 * against the logical problem, if given, and are those of the
+	 * physical samples otherwise.
+	 *
+	 * @param physical The physical samples
+	 * @param method How to resolve broken chains
+	 * @param logical The logical problem, required for MinimizeEnergy
+	 * @param seed The seed for WeightedRandom
+	 * @return samples The logical samples
+	 */
+	SampleSet unembed(const SampleSet& physical, const ChainBreakMethod method,
+			const IsingProblem* logical = nullptr, const std::uint64_t seed = 0) {
+
+		if (method == ChainBreakMethod::MinimizeEnergy && !logical) {
+			xacc::error("The minimize-energy chain break method needs the logical problem.");
+		}
+
+		const std::size_t R = physical.size(), m = chains.size();
+		const std::size_t nWords = (m + 63) / 64;
+
+		// The logical problem index of each chain, or -1
+		std::vector<int> problemIndex(m, -1);
+		if (logical) {
+			std::map<int, int> index;
+			for (int i = 0; i < logical->size(); i++) {
+				index[logical->getLabels()[i]] = i;
+			}
+			for (std::size_t k = 0; k < m; k++) {
+				auto it = index.find(labels[k]);
+				if (it != index.end()) problemIndex[k] = it->second;
+			}
+		}
+
+		std::vector<std::uint64_t> rows(R * nWords, 0), broken(R * nWords, 0);
+		std::vector<char> keep(R, 1);
+		sampleChainBreakFractions.assign(R, 0.0);
+
+		parallelFor(R, 256, [&](std::size_t begin, std::size_t end) {
+			std::vector<std::int8_t> spins(logical ? logical->size() : 0);
+			std::vector<std::size_t> brokenChains;
+			for (auto s = begin; s < end; s++) {
+				auto row = physical.getRow(s);
+				auto out = &rows[s * nWords];
+				SplitMix64 rng(seed, s);
+				brokenChains.clear();
+
+				for (std::size_t k = 0; k < m; k++) {
+					auto& chain = chains[k];
+					int ones = 0;
+					for (std::size_t w = 0; w < chain.words.size(); w++) {
+						ones += __builtin_popcountll(row[chain.words[w]] & chain.masks[w]);
+					}
+					bool up = 2 * ones >= chain.length;
+					if (ones != 0 && ones != chain.length) {
+						brokenChains.push_back(k);
+						broken[s * nWords + k / 64] |= std::uint64_t(1) << (k % 64);
+						if (method == ChainBreakMethod::WeightedRandom) {
+							up = rng.uniform() * chain.length < ones;
+						}
+					}
+					if (up) out[k / 64] |= std::uint64_t(1) << (k % 64);
+				}
+
+				sampleChainBreakFractions[s] = m > 0 ?
+						double(brokenChains.size()) / m : 0.0;
+				if (method == ChainBreakMethod::Discard && !brokenChains.empty()) {
+					keep[s] = 0;
+				}
+				if (method != ChainBreakMethod::MinimizeEnergy
+						|| brokenChains.empty()) {
+					continue;
+				}
+
+				std::fill(spins.begin(), spins.end(), -1);
+				for (std::size_t k = 0; k < m; k++) {
+					if (problemIndex[k] >= 0) {
+						spins[problemIndex[k]] = ((out[k / 64] >> (k % 64)) & 1) ? 1 : -1;
+					}
+				}
+
+				// Every flip lowers the energy, so this terminates
+				for (bool changed = true; changed;) {
+					changed = false;
+					for (auto k : brokenChains) {
+						auto i = problemIndex[k];
+						if (i < 0) continue;
+						auto field = logical->localField(i, spins.data());
+						if (field * spins[i] > 0.0) {
+							spins[i] = -spins[i];
+							out[k / 64] ^= std::uint64_t(1) << (k % 64);
+							changed = true;
+						}
+					}
+				}
+			}
+		});
+
+		// The fraction of reads in which each chain is broken
+		double totalReads = 0.0;
+		for (auto o : physical.getNumberOfOccurrences()) {
+			totalReads += o;
+		}
+		chainBreakFractions.assign(m, 0.0);
+		parallelFor(m, 64, [&](std::size_t begin, std::size_t end) {
+			for (auto k = begin; k < end; k++) {
+				double count = 0.0;
+				for (std::size_t s = 0; s < R; s++) {
+					if ((broken[s * nWords + k / 64] >> (k % 64)) & 1) {
+						count += physical.getNumberOfOccurrences()[s];
+					}
+				}
+				chainBreakFractions[k] = totalReads > 0.0 ? count / totalReads : 0.0;
+			}
+		});
+
+		SampleSet samples(labels);
+		samples.reserve(R);
+		for (std::size_t s = 0; s < R; s++) {
+			if (keep[s]) {
+				samples.appendPacked(&rows[s * nWords], physical.getEnergies()[s],
+						physical.getNumberOfOccurrences()[s]);
+			}
+		}
+
+		if (logical) {
+			EnergyEvaluator(*logical, labels).update(samples);
+		}
+
+		return samples;
+	}
+
+	/**
+	 * Return the fraction of broken chains in each physical
+	 * sample of the last unembed call.
+	 */
+	const std::vector<double>& getSampleChainBreakFractions() const {
+		return sampleChainBreakFractions;
+	}
+
+	/**
+	 * Return the fraction of reads of the last unembed call in
+	 * which each chain, in getLabels() order, was broken.
+	 */
+	const std::vector<double>& getChainBreakFractions() const {
+		return chainBreakFractions;
+	}
+
+protected:
+
+	struct Chain {
+		std::vector<std::size_t> words;
+		std::vector<std::uint64_t> masks;
+		int length;
+	};
+
+	std::vector<int> labels;
+
+	std::vector<Chain> chains;
+
+	std::vector<double> sampleChainBreakFractions;
+
+	std::vector<double> chainBreakFractions;
+};
+
+}
+}
+
+#endif